@@ -3,10 +3,17 @@
 #include <opencv2/imgproc.hpp>
 #include "OperacoesConvolucao.hpp"
 #include "MorfologiaMatematica.hpp"
+#include "PlanejadorElementoEstruturante.hpp"
 #include "DetectorBordas.hpp"
 #include "ConversorTonsCinza.hpp"
+#include "Simd.hpp"
+#include "ExecutorParalelo.hpp"
+#include "FiltrosOrdenacao.hpp"
 #include <filesystem>
 #include <chrono>
+#include <functional>
+#include <random>
+#include <tuple>
 
 /**
  * PROGRAMA DE COMPARAÇÃO: IMPLEMENTAÇÃO MANUAL vs OPENCV
@@ -50,6 +57,691 @@ double medirTempo(Func func) {
     return duracao.count();
 }
 
+// Níveis de SIMD a validar: o melhor disponível e, se for outro, o escalar
+// (os caminhos vetorizados e escalares de um mesmo operador podem ser diferentes)
+static std::vector<NivelSimd> niveisSimdTeste() {
+    std::vector<NivelSimd> niveis = {Simd::nivelDisponivel()};
+    if (Simd::nivelDisponivel() != NivelSimd::ESCALAR) {
+        niveis.push_back(NivelSimd::ESCALAR);
+    }
+    return niveis;
+}
+
+// Imagem binária (0/255) pseudoaleatória e reproduzível, com a fração "densidade" de pixels brancos
+static cv::Mat imagemBinariaAleatoria(int linhas, int colunas, double densidade, unsigned semente) {
+    std::mt19937 gerador(semente);
+    std::uniform_real_distribution<double> sorteio(0.0, 1.0);
+    cv::Mat imagem(linhas, colunas, CV_8UC1);
+    for (int y = 0; y < linhas; y++) {
+        for (int x = 0; x < colunas; x++) {
+            imagem.at<uchar>(y, x) = sorteio(gerador) < densidade ? 255 : 0;
+        }
+    }
+    return imagem;
+}
+
+// Imagens binárias de teste: densidades diferentes, lados pares e ímpares,
+// objetos encostados em todas as bordas e imagens menores que o elemento
+static std::vector<std::pair<std::string, cv::Mat>> imagensBinariasTeste() {
+    cv::Mat moldura = imagemBinariaAleatoria(48, 53, 0.5, 4);
+    for (int y = 0; y < moldura.rows; y++) {
+        for (int x = 0; x < moldura.cols; x++) {
+            if (y < 2 || y >= moldura.rows - 2 || x < 2 || x >= moldura.cols - 2) {
+                moldura.at<uchar>(y, x) = 255;
+            }
+        }
+    }
+    return {
+        {"aleatória", imagemBinariaAleatoria(67, 90, 0.5, 1)},
+        {"esparsa", imagemBinariaAleatoria(64, 71, 0.1, 2)},
+        {"densa", imagemBinariaAleatoria(51, 64, 0.9, 3)},
+        {"moldura", moldura},
+        {"toda branca", cv::Mat(40, 40, CV_8UC1, cv::Scalar(255))},
+        {"toda preta", cv::Mat::zeros(33, 40, CV_8UC1)},
+        {"minúscula", cv::Mat(6, 5, CV_8UC1, cv::Scalar(255))},
+        {"larga", imagemBinariaAleatoria(37, 200, 0.5, 5)}
+    };
+}
+
+// Elemento estruturante tamanho x tamanho com as células (dy, dx) onde ativo é verdadeiro
+static cv::Mat elementoDeForma(int tamanho, const std::function<bool(int, int)>& ativo) {
+    int raio = tamanho / 2;
+    cv::Mat elemento = cv::Mat::zeros(tamanho, tamanho, CV_8UC1);
+    for (int y = 0; y < tamanho; y++) {
+        for (int x = 0; x < tamanho; x++) {
+            elemento.at<uchar>(y, x) = ativo(y - raio, x - raio) ? 1 : 0;
+        }
+    }
+    return elemento;
+}
+
+// Referência direta da erosão/dilatação binária: testa cada célula "1" do
+// elemento em cada pixel do interior; a faixa de borda de largura raio fica zerada
+static cv::Mat morfologiaForcaBruta(const cv::Mat& binaria, const cv::Mat& elemento, bool erosao) {
+    int raio = elemento.rows / 2;
+    cv::Mat resultado = cv::Mat::zeros(binaria.size(), CV_8UC1);
+    for (int y = raio; y < binaria.rows - raio; y++) {
+        for (int x = raio; x < binaria.cols - raio; x++) {
+            bool encaixa = true;
+            bool intersecta = false;
+            for (int ky = -raio; ky <= raio; ky++) {
+                for (int kx = -raio; kx <= raio; kx++) {
+                    if (elemento.at<uchar>(ky + raio, kx + raio) == 1) {
+                        bool branco = binaria.at<uchar>(y + ky, x + kx) == 255;
+                        encaixa = encaixa && branco;
+                        intersecta = intersecta || branco;
+                    }
+                }
+            }
+            resultado.at<uchar>(y, x) = (erosao ? encaixa : intersecta) ? 255 : 0;
+        }
+    }
+    return resultado;
+}
+
+static const char* nomePlano(TipoPlano tipo) {
+    switch (tipo) {
+        case TipoPlano::FORCA_BRUTA: return "força bruta";
+        case TipoPlano::RETANGULO: return "retângulo";
+        case TipoPlano::UNIAO_RETANGULOS: return "união de retângulos";
+        case TipoPlano::CADEIA: return "cadeia";
+        case TipoPlano::DISCO: return "disco";
+        case TipoPlano::CORDAS: return "cordas";
+    }
+    return "?";
+}
+
+// Elementos que exercitam todos os tipos de plano do PlanejadorElementoEstruturante:
+// centrados e deslocados, de extensão par e ímpar, convexos ou não
+static std::vector<std::pair<std::string, cv::Mat>> elementosTeste() {
+    return {
+        {"Quadrado 3×3", MorfologiaMatematica::criarElementoEstruturante(3)},
+        {"Quadrado 9×9", MorfologiaMatematica::criarElementoEstruturante(9)},
+        {"Linha 4×1", elementoDeForma(5, [](int dy, int dx) { return dy >= -1 && dy <= 2 && dx == 1; })},
+        {"Ponto (-1,1)", elementoDeForma(3, [](int dy, int dx) { return dy == -1 && dx == 1; })},
+        {"Retângulo 2×4", elementoDeForma(5, [](int dy, int dx) { return dy >= -2 && dy <= -1 && dx >= -1 && dx <= 2; })},
+        {"Cruz 5×5", MorfologiaMatematica::criarElementoEstruturanteCruz(5)},
+        {"L 7×7", elementoDeForma(7, [](int dy, int dx) { return dy == 3 || dx == -3; })},
+        {"Octógono 15×15", elementoDeForma(15, [](int dy, int dx) {
+            return std::max(std::abs(dy) - 5, 0) + std::max(std::abs(dx) - 5, 0) <= 2; })},
+        {"Losango 7×7", elementoDeForma(7, [](int dy, int dx) { return std::abs(dy) + std::abs(dx) <= 3; })},
+        {"Anel 9×9", elementoDeForma(9, [](int dy, int dx) { int d = dy * dy + dx * dx; return d >= 6 && d <= 16; })},
+        {"Xadrez 5×5", elementoDeForma(5, [](int dy, int dx) { return ((dy + dx) & 1) == 0; })},
+        {"Disco r=6", MorfologiaMatematica::criarElementoEstruturanteDisco(6)},
+        // Janelas longas: passada horizontal de van Herk (não de duplicação) também com SIMD
+        {"Quadrado 41×41", MorfologiaMatematica::criarElementoEstruturante(41)},
+        {"Retângulo 5×35", elementoDeForma(41, [](int dy, int dx) { return dy >= -3 && dy <= 1 && dx >= -20 && dx <= 14; })}
+    };
+}
+
+// Cada tipo de plano contra a força bruta
+static bool validarPlanosMorfologia() {
+    std::vector<std::pair<std::string, cv::Mat>> elementos = elementosTeste();
+    std::vector<std::pair<std::string, cv::Mat>> imagens = imagensBinariasTeste();
+    std::vector<NivelSimd> niveis = niveisSimdTeste();
+    
+    bool tudoIdentico = true;
+    for (const auto& elemento : elementos) {
+        bool identico = true;
+        std::string nomesNiveis;
+        for (NivelSimd nivel : niveis) {
+            Simd::limitarNivel(nivel);
+            for (const auto& imagem : imagens) {
+                cv::Mat erodida = MorfologiaMatematica::erosao(imagem.second, elemento.second);
+                cv::Mat dilatada = MorfologiaMatematica::dilatacao(imagem.second, elemento.second);
+                identico = identico &&
+                           std::isinf(calcularPSNR(erodida, morfologiaForcaBruta(imagem.second, elemento.second, true))) &&
+                           std::isinf(calcularPSNR(dilatada, morfologiaForcaBruta(imagem.second, elemento.second, false)));
+            }
+            nomesNiveis += std::string(nomesNiveis.empty() ? "" : ", ") + Simd::nome(nivel);
+        }
+        Simd::limitarNivel(Simd::nivelDisponivel());
+        tudoIdentico = tudoIdentico && identico;
+        
+        std::cout << "   " << (identico ? "✅ " : "❌ ") << std::left << std::setw(16) << elemento.first << std::right
+                  << " plano: " << nomePlano(PlanejadorElementoEstruturante::planejar(elemento.second)->tipo)
+                  << " (" << nomesNiveis << ")" << std::endl;
+    }
+    return tudoIdentico;
+}
+
+// Versões por segmentos (RLE) contra as versões cv::Mat, com os mesmos elementos e imagens
+static bool validarMorfologiaRLE() {
+    typedef ImagemBinariaRLE (*OperacaoRLE)(const ImagemBinariaRLE&, const cv::Mat&);
+    typedef cv::Mat (*OperacaoMat)(const cv::Mat&, const cv::Mat&);
+    std::vector<std::tuple<std::string, OperacaoRLE, OperacaoMat>> operacoes = {
+        {"RLE erosão", MorfologiaMatematica::erosao, MorfologiaMatematica::erosao},
+        {"RLE dilatação", MorfologiaMatematica::dilatacao, MorfologiaMatematica::dilatacao},
+        {"RLE lim. int.", MorfologiaMatematica::limiteInterno, MorfologiaMatematica::limiteInterno},
+        {"RLE lim. ext.", MorfologiaMatematica::limiteExterno, MorfologiaMatematica::limiteExterno}
+    };
+    std::vector<std::pair<std::string, cv::Mat>> elementos = elementosTeste();
+    std::vector<std::pair<std::string, cv::Mat>> imagens = imagensBinariasTeste();
+    
+    bool tudoIdentico = true;
+    for (const auto& operacao : operacoes) {
+        bool identico = true;
+        for (const auto& elemento : elementos) {
+            for (const auto& imagem : imagens) {
+                ImagemBinariaRLE segmentos(imagem.second);
+                cv::Mat porSegmentos = std::get<1>(operacao)(segmentos, elemento.second).paraMat();
+                cv::Mat porPixels = std::get<2>(operacao)(imagem.second, elemento.second);
+                identico = identico && std::isinf(calcularPSNR(porSegmentos, porPixels));
+            }
+        }
+        tudoIdentico = tudoIdentico && identico;
+        
+        std::cout << "   " << (identico ? "✅ " : "❌ ") << std::left << std::setw(16) << std::get<0>(operacao)
+                  << std::right << " vs cv::Mat (" << elementos.size() << " elementos)" << std::endl;
+    }
+    return tudoIdentico;
+}
+
+// Versões compactadas (1 bit por pixel, palavras de 64 colunas) contra as versões
+// cv::Mat, para todos os elementos e imagens de teste
+static bool validarMorfologiaCompactada() {
+    typedef ImagemBinariaCompactada (*OperacaoCompactada)(const ImagemBinariaCompactada&, const cv::Mat&);
+    typedef cv::Mat (*OperacaoMat)(const cv::Mat&, const cv::Mat&);
+    std::vector<std::tuple<std::string, OperacaoCompactada, OperacaoMat>> operacoes = {
+        {"Bits erosão", MorfologiaMatematica::erosao, MorfologiaMatematica::erosao},
+        {"Bits dilatação", MorfologiaMatematica::dilatacao, MorfologiaMatematica::dilatacao},
+        {"Bits abertura", MorfologiaMatematica::abertura, MorfologiaMatematica::abertura},
+        {"Bits fechamento", MorfologiaMatematica::fechamento, MorfologiaMatematica::fechamento},
+        {"Bits lim. int.", MorfologiaMatematica::limiteInterno, MorfologiaMatematica::limiteInterno},
+        {"Bits lim. ext.", MorfologiaMatematica::limiteExterno, MorfologiaMatematica::limiteExterno}
+    };
+    std::vector<std::pair<std::string, cv::Mat>> elementos = elementosTeste();
+    std::vector<std::pair<std::string, cv::Mat>> imagens = imagensBinariasTeste();
+    
+    bool tudoIdentico = true;
+    for (const auto& operacao : operacoes) {
+        bool identico = true;
+        for (const auto& elemento : elementos) {
+            for (const auto& imagem : imagens) {
+                ImagemBinariaCompactada bits(imagem.second);
+                cv::Mat porBits = std::get<1>(operacao)(bits, elemento.second).paraMat();
+                cv::Mat porPixels = std::get<2>(operacao)(imagem.second, elemento.second);
+                identico = identico && std::isinf(calcularPSNR(porBits, porPixels));
+            }
+        }
+        tudoIdentico = tudoIdentico && identico;
+        
+        std::cout << "   " << (identico ? "✅ " : "❌ ") << std::left << std::setw(16) << std::get<0>(operacao)
+                  << std::right << " vs cv::Mat (" << elementos.size() << " elementos)" << std::endl;
+    }
+    return tudoIdentico;
+}
+
+// Elemento igual à sua rotação de 180° (a reflexão usada por aberturaCinza/fechamentoCinza)
+static bool simetricoCentral(const cv::Mat& elementoEstruturante) {
+    int lado = elementoEstruturante.rows;
+    for (int i = 0; i < lado; i++) {
+        for (int j = 0; j < lado; j++) {
+            if ((elementoEstruturante.at<uchar>(i, j) != 0) !=
+                (elementoEstruturante.at<uchar>(lado - 1 - i, lado - 1 - j) != 0)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Morfologia em tons de cinza contra cv::erode/cv::dilate/cv::morphologyEx, nos dois
+// níveis de SIMD. A borda padrão do OpenCV ignora os pixels de fora, como a nossa,
+// então o resultado deve ser idêntico. Top-hat e black-hat só com elementos
+// simétricos: o OpenCV não reflete o elemento no segundo passo da abertura/fechamento
+static bool validarMorfologiaCinza() {
+    std::vector<std::pair<std::string, cv::Mat>> elementos = elementosTeste();
+    std::vector<NivelSimd> niveis = niveisSimdTeste();
+    
+    std::mt19937 gerador(11);
+    std::uniform_int_distribution<int> sorteio(0, 255);
+    cv::Mat imagem(73, 97, CV_8UC1);
+    for (int y = 0; y < imagem.rows; y++) {
+        for (int x = 0; x < imagem.cols; x++) {
+            imagem.at<uchar>(y, x) = static_cast<uchar>(sorteio(gerador));
+        }
+    }
+    
+    bool tudoIdentico = true;
+    for (const auto& elemento : elementos) {
+        bool simetrico = simetricoCentral(elemento.second);
+        cv::Mat erodidaOpenCV, dilatadaOpenCV, gradienteOpenCV, topHatOpenCV, blackHatOpenCV;
+        cv::erode(imagem, erodidaOpenCV, elemento.second);
+        cv::dilate(imagem, dilatadaOpenCV, elemento.second);
+        cv::morphologyEx(imagem, gradienteOpenCV, cv::MORPH_GRADIENT, elemento.second);
+        if (simetrico) {
+            cv::morphologyEx(imagem, topHatOpenCV, cv::MORPH_TOPHAT, elemento.second);
+            cv::morphologyEx(imagem, blackHatOpenCV, cv::MORPH_BLACKHAT, elemento.second);
+        }
+        
+        bool identico = true;
+        for (NivelSimd nivel : niveis) {
+            Simd::limitarNivel(nivel);
+            identico = identico &&
+                       std::isinf(calcularPSNR(MorfologiaMatematica::erosaoCinza(imagem, elemento.second), erodidaOpenCV)) &&
+                       std::isinf(calcularPSNR(MorfologiaMatematica::dilatacaoCinza(imagem, elemento.second), dilatadaOpenCV)) &&
+                       std::isinf(calcularPSNR(MorfologiaMatematica::gradienteMorfologico(imagem, elemento.second), gradienteOpenCV));
+            if (simetrico) {
+                identico = identico &&
+                           std::isinf(calcularPSNR(MorfologiaMatematica::topHat(imagem, elemento.second), topHatOpenCV)) &&
+                           std::isinf(calcularPSNR(MorfologiaMatematica::blackHat(imagem, elemento.second), blackHatOpenCV));
+            }
+        }
+        Simd::limitarNivel(Simd::nivelDisponivel());
+        tudoIdentico = tudoIdentico && identico;
+        
+        std::cout << "   " << (identico ? "✅ " : "❌ ") << std::left << std::setw(16) << elemento.first << std::right
+                  << " cinza vs OpenCV: erosão, dilatação, gradiente"
+                  << (simetrico ? ", top-hat, black-hat" : "") << std::endl;
+    }
+    return tudoIdentico;
+}
+
+// Erosão/dilatação por disco (limiar sobre a transformada de distância) contra a
+// força bruta com criarElementoEstruturanteDisco, de raios pequenos (cordas) a grandes
+static bool validarMorfologiaDisco() {
+    std::vector<std::pair<std::string, cv::Mat>> imagens = imagensBinariasTeste();
+    
+    bool tudoIdentico = true;
+    for (int raio : {1, 2, 3, 6, 10, 17}) {
+        cv::Mat disco = MorfologiaMatematica::criarElementoEstruturanteDisco(raio);
+        bool identico = true;
+        for (const auto& imagem : imagens) {
+            cv::Mat erodida = MorfologiaMatematica::erosaoDisco(imagem.second, raio);
+            cv::Mat dilatada = MorfologiaMatematica::dilatacaoDisco(imagem.second, raio);
+            identico = identico &&
+                       std::isinf(calcularPSNR(erodida, morfologiaForcaBruta(imagem.second, disco, true))) &&
+                       std::isinf(calcularPSNR(dilatada, morfologiaForcaBruta(imagem.second, disco, false)));
+        }
+        tudoIdentico = tudoIdentico && identico;
+        
+        std::cout << "   " << (identico ? "✅ " : "❌ ") << std::left << std::setw(16)
+                  << ("Disco r=" + std::to_string(raio)) << std::right
+                  << " plano do elemento: " << nomePlano(PlanejadorElementoEstruturante::planejar(disco)->tipo)
+                  << std::endl;
+    }
+    return tudoIdentico;
+}
+
+// Referência direta do acerto-ou-erro: cada célula de elementoObjeto no objeto e
+// cada célula de elementoFundo no fundo; faixa de borda do maior raio zerada
+static cv::Mat acertoOuErroDireto(const cv::Mat& binaria, const cv::Mat& elementoObjeto,
+                                  const cv::Mat& elementoFundo) {
+    int raioObjeto = elementoObjeto.rows / 2;
+    int raioFundo = elementoFundo.rows / 2;
+    int raio = std::max(raioObjeto, raioFundo);
+    cv::Mat resultado = cv::Mat::zeros(binaria.size(), CV_8UC1);
+    for (int y = raio; y < binaria.rows - raio; y++) {
+        for (int x = raio; x < binaria.cols - raio; x++) {
+            bool acerto = true;
+            for (int ky = -raioObjeto; ky <= raioObjeto; ky++) {
+                for (int kx = -raioObjeto; kx <= raioObjeto; kx++) {
+                    if (elementoObjeto.at<uchar>(ky + raioObjeto, kx + raioObjeto) == 1 &&
+                        binaria.at<uchar>(y + ky, x + kx) != 255) {
+                        acerto = false;
+                    }
+                }
+            }
+            for (int ky = -raioFundo; ky <= raioFundo; ky++) {
+                for (int kx = -raioFundo; kx <= raioFundo; kx++) {
+                    if (elementoFundo.at<uchar>(ky + raioFundo, kx + raioFundo) == 1 &&
+                        binaria.at<uchar>(y + ky, x + kx) != 0) {
+                        acerto = false;
+                    }
+                }
+            }
+            resultado.at<uchar>(y, x) = acerto ? 255 : 0;
+        }
+    }
+    return resultado;
+}
+
+// Afinamento direto: as duas subiterações avaliam todos os pixels do objeto,
+// com as regras escritas sobre os vizinhos P2..P9, até nenhuma remover nada.
+// Fora da imagem é fundo.
+static cv::Mat afinamentoDireto(const cv::Mat& binaria, MorfologiaMatematica::MetodoAfinamento metodo) {
+    cv::Mat pixels = cv::Mat::zeros(binaria.rows + 2, binaria.cols + 2, CV_8UC1);
+    for (int y = 0; y < binaria.rows; y++) {
+        for (int x = 0; x < binaria.cols; x++) {
+            pixels.at<uchar>(y + 1, x + 1) = binaria.at<uchar>(y, x) == 255 ? 1 : 0;
+        }
+    }
+    
+    bool mudou = true;
+    while (mudou) {
+        mudou = false;
+        for (int subiteracao = 0; subiteracao < 2; subiteracao++) {
+            std::vector<cv::Point> remover;
+            for (int y = 1; y <= binaria.rows; y++) {
+                for (int x = 1; x <= binaria.cols; x++) {
+                    if (!pixels.at<uchar>(y, x)) {
+                        continue;
+                    }
+                    // P2 = norte, no sentido horário até P9 = noroeste
+                    int P[10] = {0, 0,
+                                 pixels.at<uchar>(y - 1, x), pixels.at<uchar>(y - 1, x + 1),
+                                 pixels.at<uchar>(y, x + 1), pixels.at<uchar>(y + 1, x + 1),
+                                 pixels.at<uchar>(y + 1, x), pixels.at<uchar>(y + 1, x - 1),
+                                 pixels.at<uchar>(y, x - 1), pixels.at<uchar>(y - 1, x - 1)};
+                    bool sai;
+                    if (metodo == MorfologiaMatematica::GUO_HALL) {
+                        int C = (!P[2] && (P[3] || P[4])) + (!P[4] && (P[5] || P[6])) +
+                                (!P[6] && (P[7] || P[8])) + (!P[8] && (P[9] || P[2]));
+                        int N1 = (P[9] || P[2]) + (P[3] || P[4]) + (P[5] || P[6]) + (P[7] || P[8]);
+                        int N2 = (P[2] || P[3]) + (P[4] || P[5]) + (P[6] || P[7]) + (P[8] || P[9]);
+                        int N = std::min(N1, N2);
+                        bool m = (subiteracao == 0) ? ((P[6] || P[7] || !P[9]) && P[8])
+                                                    : ((P[2] || P[3] || !P[5]) && P[4]);
+                        sai = C == 1 && N >= 2 && N <= 3 && !m;
+                    } else {
+                        int B = P[2] + P[3] + P[4] + P[5] + P[6] + P[7] + P[8] + P[9];
+                        int A = 0;
+                        for (int i = 2; i <= 9; i++) {
+                            A += (!P[i] && P[i == 9 ? 2 : i + 1]) ? 1 : 0;
+                        }
+                        bool m = (subiteracao == 0) ? (P[2] * P[4] * P[6] == 0 && P[4] * P[6] * P[8] == 0)
+                                                    : (P[2] * P[4] * P[8] == 0 && P[2] * P[6] * P[8] == 0);
+                        sai = B >= 2 && B <= 6 && A == 1 && m;
+                    }
+                    if (sai) {
+                        remover.push_back(cv::Point(x, y));
+                    }
+                }
+            }
+            for (const cv::Point& p : remover) {
+                pixels.at<uchar>(p.y, p.x) = 0;
+            }
+            mudou = mudou || !remover.empty();
+        }
+    }
+    
+    cv::Mat resultado(binaria.size(), CV_8UC1);
+    for (int y = 0; y < binaria.rows; y++) {
+        for (int x = 0; x < binaria.cols; x++) {
+            resultado.at<uchar>(y, x) = pixels.at<uchar>(y + 1, x + 1) ? 255 : 0;
+        }
+    }
+    return resultado;
+}
+
+// Acerto-ou-erro (cv::Mat e compactado) e afinamento contra as referências diretas
+static bool validarAcertoOuErroAfinamento() {
+    std::vector<std::pair<cv::Mat, cv::Mat>> pares = {
+        // Ponto isolado
+        {elementoDeForma(3, [](int dy, int dx) { return dy == 0 && dx == 0; }),
+         elementoDeForma(3, [](int dy, int dx) { return dy != 0 || dx != 0; })},
+        // Canto superior esquerdo
+        {elementoDeForma(3, [](int dy, int dx) { return dy >= 0 && dx >= 0 && dy + dx <= 1; }),
+         elementoDeForma(3, [](int dy, int dx) { return dy == -1 || dx == -1; })},
+        // Fim de linha horizontal
+        {elementoDeForma(3, [](int dy, int dx) { return dy == 0 && dx >= 0; }),
+         elementoDeForma(3, [](int dy, int dx) { return dy != 0 || dx == -1; })},
+        // Elementos de tamanhos diferentes: a faixa zerada é a do maior
+        {MorfologiaMatematica::criarElementoEstruturanteCruz(3),
+         elementoDeForma(5, [](int dy, int dx) { return dy == -2 && std::abs(dx) <= 1; })},
+        {elementoDeForma(5, [](int dy, int dx) { return std::abs(dy) + std::abs(dx) <= 1; }),
+         elementoDeForma(3, [](int dy, int dx) { return dy == 1 && dx == 1; })}
+    };
+    std::vector<std::pair<std::string, cv::Mat>> imagens = imagensBinariasTeste();
+    
+    bool identicoMat = true;
+    bool identicoCompactado = true;
+    for (const auto& par : pares) {
+        for (const auto& imagem : imagens) {
+            cv::Mat referencia = acertoOuErroDireto(imagem.second, par.first, par.second);
+            cv::Mat porPixels = MorfologiaMatematica::acertoOuErro(imagem.second, par.first, par.second);
+            cv::Mat porPalavras = MorfologiaMatematica::acertoOuErro(
+                ImagemBinariaCompactada(imagem.second), par.first, par.second).paraMat();
+            identicoMat = identicoMat && std::isinf(calcularPSNR(porPixels, referencia));
+            identicoCompactado = identicoCompactado && std::isinf(calcularPSNR(porPalavras, referencia));
+        }
+    }
+    std::cout << "   " << (identicoMat ? "✅ " : "❌ ") << std::left << std::setw(16) << "Acerto-ou-erro"
+              << std::right << " cv::Mat vs direto (" << pares.size() << " pares)" << std::endl;
+    std::cout << "   " << (identicoCompactado ? "✅ " : "❌ ") << std::left << std::setw(16) << "Acerto-ou-erro"
+              << std::right << " compactado vs direto" << std::endl;
+    
+    // Afinamento: objetos grossos e convexos, além das imagens de teste
+    cv::Mat formas = cv::Mat::zeros(60, 80, CV_8UC1);
+    for (int y = 0; y < formas.rows; y++) {
+        for (int x = 0; x < formas.cols; x++) {
+            bool retangulo = y >= 5 && y < 20 && x >= 3 && x < 70;
+            bool disco = (y - 40) * (y - 40) + (x - 25) * (x - 25) <= 15 * 15;
+            bool anel = std::abs((y - 40) * (y - 40) + (x - 62) * (x - 62) - 100) <= 30;
+            formas.at<uchar>(y, x) = (retangulo || disco || anel) ? 255 : 0;
+        }
+    }
+    imagens.push_back({"formas", formas});
+    
+    bool tudoIdentico = identicoMat && identicoCompactado;
+    for (auto metodo : {MorfologiaMatematica::ZHANG_SUEN, MorfologiaMatematica::GUO_HALL}) {
+        bool identico = true;
+        for (const auto& imagem : imagens) {
+            cv::Mat afinada = MorfologiaMatematica::afinamento(imagem.second, metodo);
+            identico = identico && std::isinf(calcularPSNR(afinada, afinamentoDireto(imagem.second, metodo)));
+        }
+        tudoIdentico = tudoIdentico && identico;
+        
+        std::cout << "   " << (identico ? "✅ " : "❌ ") << std::left << std::setw(16)
+                  << (metodo == MorfologiaMatematica::GUO_HALL ? "Afinamento G-H" : "Afinamento Z-S")
+                  << std::right << " vs subiterações completas" << std::endl;
+    }
+    return tudoIdentico;
+}
+
+// Reconstrução (fila de Vincent) contra a definição: dilatação/erosão geodésica
+// repetida até estabilizar, inclusive junto à borda da imagem
+static bool validarReconstrucaoGeodesica() {
+    std::vector<std::pair<std::string, cv::Mat>> imagens = imagensBinariasTeste();
+    
+    bool tudoIdentico = true;
+    for (int conectividade : {4, 8}) {
+        cv::Mat elemento = (conectividade == 8) ? MorfologiaMatematica::criarElementoEstruturante(3)
+                                                : MorfologiaMatematica::criarElementoEstruturanteCruz(3);
+        bool identico = true;
+        for (size_t i = 0; i < imagens.size(); i++) {
+            const cv::Mat& mascara = imagens[i].second;
+            cv::Mat marcador = imagemBinariaAleatoria(mascara.rows, mascara.cols, 0.02, 100 + static_cast<unsigned>(i));
+            
+            cv::Mat dilatada = marcador;
+            cv::Mat erodida = marcador;
+            for (int passo = 0; passo < mascara.rows * mascara.cols; passo++) {
+                cv::Mat seguinte = MorfologiaMatematica::dilatacaoGeodesica(dilatada, mascara, elemento);
+                bool estavel = std::isinf(calcularPSNR(seguinte, dilatada));
+                dilatada = seguinte;
+                if (estavel) {
+                    break;
+                }
+            }
+            for (int passo = 0; passo < mascara.rows * mascara.cols; passo++) {
+                cv::Mat seguinte = MorfologiaMatematica::erosaoGeodesica(erodida, mascara, elemento);
+                bool estavel = std::isinf(calcularPSNR(seguinte, erodida));
+                erodida = seguinte;
+                if (estavel) {
+                    break;
+                }
+            }
+            
+            cv::Mat porDilatacao = MorfologiaMatematica::reconstrucaoPorDilatacao(marcador, mascara, conectividade);
+            cv::Mat porErosao = MorfologiaMatematica::reconstrucaoPorErosao(marcador, mascara, conectividade);
+            identico = identico && std::isinf(calcularPSNR(porDilatacao, dilatada)) &&
+                       std::isinf(calcularPSNR(porErosao, erodida));
+        }
+        tudoIdentico = tudoIdentico && identico;
+        
+        std::cout << "   " << (identico ? "✅ " : "❌ ") << std::left << std::setw(16)
+                  << ("Reconstrução " + std::to_string(conectividade)) << std::right
+                  << " vs geodésica repetida" << std::endl;
+    }
+    return tudoIdentico;
+}
+
+// Referência direta dos filtros de ordenação: ordena a janela de cada pixel
+// (de tamanho/2 antes a tamanho - 1 - tamanho/2 depois), com a mesma borda
+static cv::Mat ordenacaoDireta(const cv::Mat& imagem, int tamanho, int posto, ModoBorda borda,
+                               uchar valorConstante) {
+    int antes = tamanho / 2;
+    int depois = tamanho - 1 - antes;
+    cv::Mat resultado(imagem.size(), CV_8UC1);
+    std::vector<uchar> janela;
+    for (int y = 0; y < imagem.rows; y++) {
+        for (int x = 0; x < imagem.cols; x++) {
+            janela.clear();
+            for (int dy = -antes; dy <= depois; dy++) {
+                for (int dx = -antes; dx <= depois; dx++) {
+                    int yy = BufferLinhasBorda::mapearIndice(y + dy, imagem.rows, borda);
+                    int xx = BufferLinhasBorda::mapearIndice(x + dx, imagem.cols, borda);
+                    janela.push_back((yy < 0 || xx < 0) ? valorConstante : imagem.at<uchar>(yy, xx));
+                }
+            }
+            std::nth_element(janela.begin(), janela.begin() + posto, janela.end());
+            resultado.at<uchar>(y, x) = janela[posto];
+        }
+    }
+    return resultado;
+}
+
+// Mediana, percentil e posto contra a ordenação direta, pelos dois caminhos
+// (rede de seleção e histogramas) e em volta da troca entre eles: com SIMD a
+// rede vai até 7x7; sem SIMD, até 3x3. Janelas pares e ímpares, percentis 0 e
+// 100, todos os modos de borda; a largura cruza as faixas de ambos os caminhos.
+static bool validarFiltrosOrdenacao() {
+    std::mt19937 gerador(7);
+    cv::Mat imagem(19, 1100, CV_8UC1);
+    for (int y = 0; y < imagem.rows; y++) {
+        for (int x = 0; x < imagem.cols; x++) {
+            imagem.at<uchar>(y, x) = static_cast<uchar>(gerador() % 256);
+        }
+    }
+    std::vector<NivelSimd> niveis = niveisSimdTeste();
+    std::vector<ModoBorda> bordas = {ModoBorda::REFLETIR_101, ModoBorda::REFLETIR, ModoBorda::REPLICAR,
+                                     ModoBorda::CIRCULAR, ModoBorda::CONSTANTE};
+    
+    bool tudoIdentico = true;
+    for (int tamanho : {2, 3, 4, 5, 6, 7, 8, 9, 15}) {
+        int ultimo = tamanho * tamanho - 1;
+        
+        // Referências calculadas uma vez, comparadas com cada nível de SIMD
+        std::vector<std::function<cv::Mat()>> filtros;
+        std::vector<cv::Mat> referencias;
+        for (ModoBorda borda : bordas) {
+            filtros.push_back([=]() { return FiltrosOrdenacao::filtroMediana(imagem, tamanho, borda, 77); });
+            referencias.push_back(ordenacaoDireta(imagem, tamanho, tamanho * tamanho / 2, borda, 77));
+        }
+        filtros.push_back([=]() { return FiltrosOrdenacao::filtroPercentil(imagem, tamanho, 0.0); });
+        referencias.push_back(ordenacaoDireta(imagem, tamanho, 0, ModoBorda::REFLETIR_101, 0));
+        filtros.push_back([=]() { return FiltrosOrdenacao::filtroPercentil(imagem, tamanho, 100.0); });
+        referencias.push_back(ordenacaoDireta(imagem, tamanho, ultimo, ModoBorda::REFLETIR_101, 0));
+        filtros.push_back([=]() { return FiltrosOrdenacao::filtroPosto(imagem, tamanho, ultimo / 3); });
+        referencias.push_back(ordenacaoDireta(imagem, tamanho, ultimo / 3, ModoBorda::REFLETIR_101, 0));
+        
+        bool identico = true;
+        std::string caminhos;
+        for (NivelSimd nivel : niveis) {
+            Simd::limitarNivel(nivel);
+            for (size_t i = 0; i < filtros.size(); i++) {
+                identico = identico && std::isinf(calcularPSNR(filtros[i](), referencias[i]));
+            }
+            bool rede = tamanho / 2 <= 3 && (tamanho / 2 <= 1 || nivel != NivelSimd::ESCALAR);
+            caminhos += std::string(caminhos.empty() ? "" : " | ") + Simd::nome(nivel) + ": " +
+                        (rede ? "rede" : "histogramas");
+        }
+        Simd::limitarNivel(Simd::nivelDisponivel());
+        tudoIdentico = tudoIdentico && identico;
+        
+        std::cout << "   " << (identico ? "✅ " : "❌ ") << std::left << std::setw(16)
+                  << ("Janela " + std::to_string(tamanho) + "×" + std::to_string(tamanho)) << std::right
+                  << " " << caminhos << std::endl;
+    }
+    return tudoIdentico;
+}
+
+// Convolução (correlação, como no projeto) somada diretamente em double,
+// truncada e saturada como OperacoesConvolucao::tratarOverflow
+static cv::Mat convolucaoDiretaReferencia(const cv::Mat& imagem, const cv::Mat& kernel, ModoBorda borda,
+                                          uchar valorConstante) {
+    int raio = kernel.rows / 2;
+    cv::Mat resultado(imagem.size(), CV_8UC1);
+    for (int y = 0; y < imagem.rows; y++) {
+        for (int x = 0; x < imagem.cols; x++) {
+            double soma = 0.0;
+            for (int i = 0; i < kernel.rows; i++) {
+                int yy = BufferLinhasBorda::mapearIndice(y + i - raio, imagem.rows, borda);
+                for (int j = 0; j < kernel.cols; j++) {
+                    int xx = BufferLinhasBorda::mapearIndice(x + j - raio, imagem.cols, borda);
+                    uchar pixel = (yy < 0 || xx < 0) ? valorConstante : imagem.at<uchar>(yy, xx);
+                    soma += kernel.at<double>(i, j) * pixel;
+                }
+            }
+            resultado.at<uchar>(y, x) = static_cast<uchar>(std::min(255.0, std::max(0.0, soma)));
+        }
+    }
+    return resultado;
+}
+
+static int diferencaMaxima(const cv::Mat& a, const cv::Mat& b) {
+    int maxima = 0;
+    for (int y = 0; y < a.rows; y++) {
+        for (int x = 0; x < a.cols; x++) {
+            maxima = std::max(maxima, std::abs(a.at<uchar>(y, x) - b.at<uchar>(y, x)));
+        }
+    }
+    return maxima;
+}
+
+// Convolução por FFT (overlap-add) e aplicarConvolucao (que escolhe FFT ou soma
+// direta pelo modelo de custo) contra a soma direta, com kernels não separáveis
+// grandes e todos os modos de borda. A imagem tem mais linhas que uma faixa do
+// overlap-add e mais colunas que um par de blocos; tolera-se 1 nível de diferença
+// (arredondamento da FFT e quantização em ponto fixo perto do truncamento).
+static bool validarConvolucaoFFT() {
+    std::mt19937 gerador(13);
+    std::uniform_real_distribution<double> sorteio(0.0, 1.0);
+    cv::Mat imagem(261, 300, CV_8UC1);
+    for (int y = 0; y < imagem.rows; y++) {
+        for (int x = 0; x < imagem.cols; x++) {
+            imagem.at<uchar>(y, x) = static_cast<uchar>(gerador() % 256);
+        }
+    }
+    std::vector<ModoBorda> bordas = {ModoBorda::REFLETIR_101, ModoBorda::REFLETIR, ModoBorda::REPLICAR,
+                                     ModoBorda::CIRCULAR, ModoBorda::CONSTANTE};
+    const char* nomesBordas[] = {"refletir 101", "refletir", "replicar", "circular", "constante"};
+    
+    bool tudoProximo = true;
+    for (int tamanho : {9, 15, 31}) {
+        // Pesos aleatórios positivos (posto cheio) normalizados para soma 1
+        cv::Mat kernel(tamanho, tamanho, CV_64F);
+        double soma = 0.0;
+        for (int i = 0; i < tamanho; i++) {
+            for (int j = 0; j < tamanho; j++) {
+                kernel.at<double>(i, j) = sorteio(gerador);
+                soma += kernel.at<double>(i, j);
+            }
+        }
+        for (int i = 0; i < tamanho; i++) {
+            for (int j = 0; j < tamanho; j++) {
+                kernel.at<double>(i, j) /= soma;
+            }
+        }
+        
+        for (size_t b = 0; b < bordas.size(); b++) {
+            cv::Mat direta = convolucaoDiretaReferencia(imagem, kernel, bordas[b], 90);
+            int diferencaFFT = diferencaMaxima(
+                OperacoesConvolucao::aplicarConvolucaoFFT(imagem, kernel, bordas[b], 90), direta);
+            int diferencaAutomatica = diferencaMaxima(
+                OperacoesConvolucao::aplicarConvolucao(imagem, kernel, bordas[b], 90), direta);
+            bool proximo = diferencaFFT <= 1 && diferencaAutomatica <= 1;
+            tudoProximo = tudoProximo && proximo;
+            
+            std::cout << "   " << (proximo ? "✅ " : "❌ ") << "Kernel " << std::left << std::setw(3) << tamanho
+                      << std::setw(14) << nomesBordas[b] << std::right
+                      << " dif. máx. FFT: " << diferencaFFT << " | automática: " << diferencaAutomatica << std::endl;
+        }
+    }
+    return tudoProximo;
+}
+
 int main() {
     std::cout << "\n╔══════════════════════════════════════════════════════════╗" << std::endl;
     std::cout << "║   COMPARAÇÃO: IMPLEMENTAÇÃO MANUAL vs OPENCV            ║" << std::endl;
@@ -203,6 +895,103 @@ int main() {
     
     std::cout << "└────────────────────────┴──────────────┴──────────────┴──────────────┴──────────────┘" << std::endl;
     
+    // ==========================================
+    // 4. VALIDAÇÃO SIMD vs ESCALAR
+    // ==========================================
+    // Os núcleos vetorizados devem produzir exatamente os mesmos bytes que a referência escalar
+    std::cout << "\n🔍 Validação SIMD (" << Simd::nome(Simd::nivelDisponivel()) << ") vs Escalar" << std::endl;
+    bool simdIdentico = true;
+    {
+        std::vector<std::pair<std::string, cv::Mat>> kernels = {
+            {"Passa-Alta 3×3", OperacoesConvolucao::criarKernelPassaAlta(3)},
+            {"Passa-Alta 5×5", OperacoesConvolucao::criarKernelPassaAlta(5)},
+            {"Passa-Alta 7×7", OperacoesConvolucao::criarKernelPassaAlta(7)},
+            {"Nitidez 3×3", OperacoesConvolucao::criarKernelNitidez(3)}
+        };
+        
+        for (const auto& item : kernels) {
+            cv::Mat resultadoEscalar, resultadoSimd;
+            
+            Simd::limitarNivel(NivelSimd::ESCALAR);
+            double tempoEscalar = medirTempo([&]() {
+                resultadoEscalar = OperacoesConvolucao::aplicarConvolucao(imagemConvolucao, item.second);
+            });
+            
+            Simd::limitarNivel(Simd::nivelDisponivel());
+            double tempoSimd = medirTempo([&]() {
+                resultadoSimd = OperacoesConvolucao::aplicarConvolucao(imagemConvolucao, item.second);
+            });
+            
+            bool identico = std::isinf(calcularPSNR(resultadoEscalar, resultadoSimd));
+            simdIdentico = simdIdentico && identico;
+            
+            std::cout << "   " << (identico ? "✅ " : "❌ ") << std::left << std::setw(16) << item.first << std::right
+                      << std::fixed << std::setprecision(2)
+                      << " escalar " << std::setw(8) << tempoEscalar << " ms | SIMD "
+                      << std::setw(8) << tempoSimd << " ms" << std::endl;
+        }
+    }
+    
+    // ==========================================
+    // 5. VALIDAÇÃO PARALELO vs SERIAL
+    // ==========================================
+    // A divisão em faixas não pode alterar nenhum pixel (inclusive nas emendas)
+    int threadsDisponiveis = ExecutorParalelo::numeroThreads();
+    std::cout << "\n🔍 Validação Paralelo (" << threadsDisponiveis << " threads) vs Serial" << std::endl;
+    bool paraleloIdentico = true;
+    {
+        cv::Mat elementoEstruturante = MorfologiaMatematica::criarElementoEstruturante(3);
+        std::vector<std::pair<std::string, std::function<cv::Mat()>>> operacoes = {
+            {"Passa-Alta 5×5", [&]() { return OperacoesConvolucao::aplicarConvolucao(imagemConvolucao, OperacoesConvolucao::criarKernelPassaAlta(5)); }},
+            {"Sobel", [&]() { return DetectorBordas::sobel(imagemBordas); }},
+            {"Erosão 3×3", [&]() { return MorfologiaMatematica::erosao(imagemBordas, elementoEstruturante); }}
+        };
+        
+        for (const auto& item : operacoes) {
+            cv::Mat resultadoSerial, resultadoParalelo;
+            
+            ExecutorParalelo::definirNumeroThreads(1);
+            double tempoSerial = medirTempo([&]() { resultadoSerial = item.second(); });
+            
+            ExecutorParalelo::definirNumeroThreads(threadsDisponiveis);
+            double tempoParalelo = medirTempo([&]() { resultadoParalelo = item.second(); });
+            
+            bool identico = std::isinf(calcularPSNR(resultadoSerial, resultadoParalelo));
+            paraleloIdentico = paraleloIdentico && identico;
+            
+            std::cout << "   " << (identico ? "✅ " : "❌ ") << std::left << std::setw(16) << item.first << std::right
+                      << std::fixed << std::setprecision(2)
+                      << " serial  " << std::setw(8) << tempoSerial << " ms | paralelo "
+                      << std::setw(8) << tempoParalelo << " ms" << std::endl;
+        }
+    }
+
+    // ==========================================
+    // 6. VALIDAÇÃO MORFOLOGIA vs REFERÊNCIA DIRETA
+    // ==========================================
+    // Os caminhos rápidos (planos, RLE, disco...) devem reproduzir a definição pixel a pixel
+    std::cout << "\n🔍 Validação Morfologia vs Força Bruta (" << imagensBinariasTeste().size()
+              << " imagens de teste)" << std::endl;
+    bool morfologiaIdentica = validarPlanosMorfologia();
+    morfologiaIdentica = validarMorfologiaRLE() && morfologiaIdentica;
+    morfologiaIdentica = validarMorfologiaCompactada() && morfologiaIdentica;
+    morfologiaIdentica = validarMorfologiaCinza() && morfologiaIdentica;
+    morfologiaIdentica = validarMorfologiaDisco() && morfologiaIdentica;
+    morfologiaIdentica = validarAcertoOuErroAfinamento() && morfologiaIdentica;
+    morfologiaIdentica = validarReconstrucaoGeodesica() && morfologiaIdentica;
+
+    // ==========================================
+    // 7. VALIDAÇÃO FILTROS DE ORDENAÇÃO vs ORDENAÇÃO DIRETA
+    // ==========================================
+    std::cout << "\n🔍 Validação Filtros de Ordenação vs Ordenação Direta" << std::endl;
+    bool ordenacaoIdentica = validarFiltrosOrdenacao();
+
+    // ==========================================
+    // 8. VALIDAÇÃO CONVOLUÇÃO FFT vs SOMA DIRETA
+    // ==========================================
+    std::cout << "\n🔍 Validação Convolução FFT vs Soma Direta (kernels não separáveis)" << std::endl;
+    bool convolucaoFFTProxima = validarConvolucaoFFT();
+
     // ==========================================
     // ANÁLISE FINAL
     // ==========================================
@@ -214,11 +1003,19 @@ int main() {
     
     std::cout << "\n📊 CONCLUSÕES:\n" << std::endl;
     std::cout << "1. ✅ Implementação manual produz resultados equivalentes ao OpenCV" << std::endl;
-    std::cout << "2. ⚠️  Tempo de execução maior (esperado sem otimizações SIMD)" << std::endl;
-    std::cout << "3. ✅ Validação de conformidade: Aprovada" << std::endl;
-    std::cout << "4. ✅ Todas as 3 categorias de algoritmos validadas" << std::endl;
+    std::cout << "2. ✅ Convolução com núcleos SIMD (" << Simd::nome(Simd::nivelAtivo()) << ") escolhidos em tempo de execução" << std::endl;
+    std::cout << "3. " << (simdIdentico ? "✅" : "❌") << " Validação SIMD vs escalar: "
+              << (simdIdentico ? "idêntico bit a bit" : "DIVERGENTE") << std::endl;
+    std::cout << "4. " << (paraleloIdentico ? "✅" : "❌") << " Execução em " << threadsDisponiveis
+              << " threads: " << (paraleloIdentico ? "idêntica à serial" : "DIVERGENTE") << std::endl;
+    std::cout << "5. ✅ Todas as 3 categorias de algoritmos validadas" << std::endl;
+    std::cout << "6. " << (morfologiaIdentica ? "✅" : "❌") << " Morfologia rápida vs referência direta: "
+              << (morfologiaIdentica ? "idêntica" : "DIVERGENTE") << std::endl;
+    std::cout << "7. " << (ordenacaoIdentica ? "✅" : "❌") << " Mediana/percentil (rede e histogramas): "
+              << (ordenacaoIdentica ? "idênticos à ordenação direta" : "DIVERGENTE") << std::endl;
+    std::cout << "8. " << (convolucaoFFTProxima ? "✅" : "❌") << " Convolução FFT (overlap-add) vs soma direta: "
+              << (convolucaoFFTProxima ? "diferença ≤ 1" : "DIVERGENTE") << std::endl;
     std::cout << "\n📌 NOTA: A diferença de performance é proporcional ao tamanho da imagem." << std::endl;
-    std::cout << "   OpenCV usa otimizações de hardware (SIMD) indisponíveis em implementação manual." << std::endl;
     
     std::cout << "\n💾 Imagens de comparação salvas em: data/comparacao/" << std::endl;
     std::cout << "   - 01_convolucao_manual.png vs 01_convolucao_opencv.png (Cinza4.jpeg)" << std::endl;
@@ -227,5 +1024,6 @@ int main() {
     
     std::cout << "\n✅ Comparação concluída com sucesso!\n" << std::endl;
     
-    return 0;
+    return (simdIdentico && paraleloIdentico && morfologiaIdentica && ordenacaoIdentica &&
+            convolucaoFFTProxima) ? 0 : 1;
 }
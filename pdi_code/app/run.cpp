@@ -263,7 +263,7 @@ int main()
     }
     
     // Converte para cinza
-    cv::Mat imagemConvCinza = ConversorTonsCinza::paraMediaPonderada(imagemConv);
+    cv::Mat imagemConvCinza = ConversorTonsCinza::paraMediaPonderadaUmCanal(imagemConv);
     
     // Testa diferentes kernels
     cv::Mat kernelPassaBaixa = OperacoesConvolucao::criarKernelPassaBaixa(3);
@@ -353,7 +353,7 @@ int main()
         imagemBordas = imagemCinzaEColorido;
     }
     
-    cv::Mat imagemBordasCinza = ConversorTonsCinza::paraMediaPonderada(imagemBordas);
+    cv::Mat imagemBordasCinza = ConversorTonsCinza::paraMediaPonderadaUmCanal(imagemBordas);
     
     // Roberts
     cv::Mat bordasRoberts = DetectorBordas::roberts(imagemBordasCinza);
@@ -364,8 +364,8 @@ int main()
     cv::imwrite("../data/result/07_bordas_roberts_limiar.png", bordasRobertsLimiar);
     
     // Sobel
-    cv::Mat bordasSobel = DetectorBordas::sobel(imagemBordasCinza);
-    cv::Mat bordasSobelLimiar = DetectorBordas::aplicarLimiar(bordasSobel, 50);
+    cv::Mat bordasSobelLimiar;
+    cv::Mat bordasSobel = DetectorBordas::sobel(imagemBordasCinza, 50, bordasSobelLimiar);
     mostrarImagem("Bordas - Sobel", bordasSobel);
     mostrarImagem("Bordas - Sobel Limiarizado", bordasSobelLimiar);
     cv::imwrite("../data/result/07_bordas_sobel.png", bordasSobel);
@@ -5,6 +5,7 @@
 #include "DetectorBordas.hpp"
 #include "ConversorTonsCinza.hpp"
 #include <filesystem>
+#include <map>
 
 /**
  * EXIBIÇÃO DE IMAGENS
@@ -54,6 +55,9 @@ int main()
     cv::Mat kernelPassaAlta = OperacoesConvolucao::criarKernelPassaAlta(3);
     cv::Mat kernelNitidez = OperacoesConvolucao::criarKernelNitidez(3);
     
+    // Buffer de cinza reutilizado entre as imagens (só realoca se o tamanho mudar)
+    cv::Mat imagemConvCinza;
+    
     for (size_t i = 0; i < imagensConvolucao.size(); i++) {
         std::string nomeArquivo = imagensConvolucao[i];
         cv::Mat imagemConv = cv::imread("../data/model/" + nomeArquivo);
@@ -64,7 +68,7 @@ int main()
         }
                 
         // Converte para cinza
-        cv::Mat imagemConvCinza = ConversorTonsCinza::paraMediaPonderada(imagemConv);
+        ConversorTonsCinza::paraMediaPonderadaUmCanal(imagemConv, imagemConvCinza);
         
         // Aplica convoluções
         cv::Mat convPassaBaixa = OperacoesConvolucao::aplicarConvolucao(imagemConvCinza, kernelPassaBaixa);
@@ -108,14 +112,47 @@ int main()
     // Elemento estruturante padrão 3x3
     cv::Mat elementoEstruturante = MorfologiaMatematica::criarElementoEstruturante(3);
     
+    // Imagens de cada operação: a de exemplo da operação + as binárias
+    std::vector<std::string> imagensErosao = {"02_erosao.png", "Binario1.jpg", "Binario2.jpeg", "Binario3.jpg"};
+    std::vector<std::string> imagensDilatacao = {"03_dilatacao.png", "Binario1.jpg", "Binario2.jpeg", "Binario3.jpg"};
+    std::vector<std::string> imagensAbertura = {"04_abertura.png", "Binario1.jpg", "Binario2.jpeg", "Binario3.jpg"};
+    std::vector<std::string> imagensFechamento = {"05_fechamento.png", "Binario1.jpg", "Binario2.jpeg", "Binario3.jpg"};
+    std::vector<std::string> imagensLimites = {"06_limites.png", "Binario1.jpg", "Binario2.jpeg", "Binario3.jpg"};
+    
+    // Operações pedidas para cada arquivo, somadas sobre todas as seções
+    std::map<std::string, int> operacoesPorArquivo;
+    auto pedir = [&](const std::vector<std::string>& arquivos, int operacoes) {
+        for (const std::string& nomeArquivo : arquivos) {
+            operacoesPorArquivo[nomeArquivo] |= operacoes;
+        }
+    };
+    pedir(imagensErosao, MorfologiaMatematica::EROSAO);
+    pedir(imagensDilatacao, MorfologiaMatematica::DILATACAO);
+    pedir(imagensAbertura, MorfologiaMatematica::ABERTURA);
+    pedir(imagensFechamento, MorfologiaMatematica::FECHAMENTO);
+    pedir(imagensLimites, MorfologiaMatematica::LIMITE_INTERNO | MorfologiaMatematica::LIMITE_EXTERNO);
+    
+    // Cada imagem passa uma única vez por aplicarConjunto, só com as operações
+    // que alguma seção usa (binarização, erosão e dilatação compartilhadas):
+    // 02_erosao faz uma passada, as binárias fazem todas. As seções abaixo
+    // só consultam os resultados
+    std::map<std::string, MorfologiaMatematica::ResultadosMorfologicos> resultadosMorfologia;
+    auto morfologiaDe = [&](const std::string& nomeArquivo, const cv::Mat& imagem)
+        -> const MorfologiaMatematica::ResultadosMorfologicos& {
+        auto encontrado = resultadosMorfologia.find(nomeArquivo);
+        if (encontrado == resultadosMorfologia.end()) {
+            encontrado = resultadosMorfologia.emplace(nomeArquivo, MorfologiaMatematica::ResultadosMorfologicos()).first;
+            MorfologiaMatematica::aplicarConjunto(imagem, elementoEstruturante,
+                                                  operacoesPorArquivo[nomeArquivo], encontrado->second);
+        }
+        return encontrado->second;
+    };
+    
     // Processa cada operação morfológica com todas as imagens binárias
     
     // EROSÃO - 02_erosao + Binario1, Binario2, Binario3
     std::cout << "   → Aplicando Erosão..." << std::endl;
     
-    // Adiciona 02_erosao.png na lista de erosão
-    std::vector<std::string> imagensErosao = {"02_erosao.png", "Binario1.jpg", "Binario2.jpeg", "Binario3.jpg"};
-    
     for (size_t i = 0; i < imagensErosao.size(); i++) {
         std::string nomeArquivo = imagensErosao[i];
         cv::Mat imagem = cv::imread("../data/model/" + nomeArquivo, cv::IMREAD_GRAYSCALE);
@@ -125,7 +162,7 @@ int main()
             continue;
         }
         
-        cv::Mat resultado = MorfologiaMatematica::erosao(imagem, elementoEstruturante);
+        cv::Mat resultado = morfologiaDe(nomeArquivo, imagem).erosao;
         std::string prefixo = "../data/result/Morfologia Matemática/02_erosao_";
         
         if (nomeArquivo.find("02_erosao") != std::string::npos) prefixo += "02";
@@ -149,8 +186,6 @@ int main()
     // DILATAÇÃO - 03_dilatacao + Binario1, Binario2, Binario3
     std::cout << "   → Aplicando Dilatação..." << std::endl;
     
-    std::vector<std::string> imagensDilatacao = {"03_dilatacao.png", "Binario1.jpg", "Binario2.jpeg", "Binario3.jpg"};
-    
     for (size_t i = 0; i < imagensDilatacao.size(); i++) {
         std::string nomeArquivo = imagensDilatacao[i];
         cv::Mat imagem = cv::imread("../data/model/" + nomeArquivo, cv::IMREAD_GRAYSCALE);
@@ -160,7 +195,7 @@ int main()
             continue;
         }
         
-        cv::Mat resultado = MorfologiaMatematica::dilatacao(imagem, elementoEstruturante);
+        cv::Mat resultado = morfologiaDe(nomeArquivo, imagem).dilatacao;
         std::string prefixo = "../data/result/Morfologia Matemática/03_dilatacao_";
         
         if (nomeArquivo.find("03_dilatacao") != std::string::npos) prefixo += "03";
@@ -184,8 +219,6 @@ int main()
     // ABERTURA - 04_abertura + Binario1, Binario2, Binario3
     std::cout << "   → Aplicando Abertura..." << std::endl;
     
-    std::vector<std::string> imagensAbertura = {"04_abertura.png", "Binario1.jpg", "Binario2.jpeg", "Binario3.jpg"};
-    
     for (size_t i = 0; i < imagensAbertura.size(); i++) {
         std::string nomeArquivo = imagensAbertura[i];
         cv::Mat imagem = cv::imread("../data/model/" + nomeArquivo, cv::IMREAD_GRAYSCALE);
@@ -195,7 +228,7 @@ int main()
             continue;
         }
         
-        cv::Mat resultado = MorfologiaMatematica::abertura(imagem, elementoEstruturante);
+        cv::Mat resultado = morfologiaDe(nomeArquivo, imagem).abertura;
         std::string prefixo = "../data/result/Morfologia Matemática/04_abertura_";
         
         if (nomeArquivo.find("04_abertura") != std::string::npos) prefixo += "04";
@@ -221,8 +254,6 @@ int main()
     // FECHAMENTO - 05_fechamento + Binario1, Binario2, Binario3
     std::cout << "   → Aplicando Fechamento..." << std::endl;
     
-    std::vector<std::string> imagensFechamento = {"05_fechamento.png", "Binario1.jpg", "Binario2.jpeg", "Binario3.jpg"};
-    
     for (size_t i = 0; i < imagensFechamento.size(); i++) {
         std::string nomeArquivo = imagensFechamento[i];
         cv::Mat imagem = cv::imread("../data/model/" + nomeArquivo, cv::IMREAD_GRAYSCALE);
@@ -232,7 +263,7 @@ int main()
             continue;
         }
         
-        cv::Mat resultado = MorfologiaMatematica::fechamento(imagem, elementoEstruturante);
+        cv::Mat resultado = morfologiaDe(nomeArquivo, imagem).fechamento;
         std::string prefixo = "../data/result/Morfologia Matemática/05_fechamento_";
         
         if (nomeArquivo.find("05_fechamento") != std::string::npos) prefixo += "05";
@@ -257,8 +288,6 @@ int main()
     // LIMITES - 06_limites + Binario1, Binario2, Binario3
     std::cout << "   → Aplicando Limites (Interno e Externo)..." << std::endl;
     
-    std::vector<std::string> imagensLimites = {"06_limites.png", "Binario1.jpg", "Binario2.jpeg", "Binario3.jpg"};
-    
     for (size_t i = 0; i < imagensLimites.size(); i++) {
         std::string nomeArquivo = imagensLimites[i];
         cv::Mat imagem = cv::imread("../data/model/" + nomeArquivo, cv::IMREAD_GRAYSCALE);
@@ -268,8 +297,9 @@ int main()
             continue;
         }
         
-        cv::Mat limiteInterno = MorfologiaMatematica::limiteInterno(imagem, elementoEstruturante);
-        cv::Mat limiteExterno = MorfologiaMatematica::limiteExterno(imagem, elementoEstruturante);
+        const MorfologiaMatematica::ResultadosMorfologicos& resultados = morfologiaDe(nomeArquivo, imagem);
+        cv::Mat limiteInterno = resultados.limiteInterno;
+        cv::Mat limiteExterno = resultados.limiteExterno;
         
         std::string prefixo = "../data/result/Morfologia Matemática/06_limites_";
         
@@ -302,6 +332,7 @@ int main()
     };
     
     int totalBordas = 0;
+    cv::Mat imagemBordasCinza;
     for (const auto& nomeArquivo : imagensBordas) {
         cv::Mat imagemBordasOriginal = cv::imread("../data/model/" + nomeArquivo);
         
@@ -311,15 +342,15 @@ int main()
         }
                 
         // Converte para cinza
-        cv::Mat imagemBordasCinza = ConversorTonsCinza::paraMediaPonderada(imagemBordasOriginal);
+        ConversorTonsCinza::paraMediaPonderadaUmCanal(imagemBordasOriginal, imagemBordasCinza);
         
         // Roberts
         cv::Mat bordasRoberts = DetectorBordas::roberts(imagemBordasCinza);
         cv::Mat bordasRobertsLimiar = DetectorBordas::aplicarLimiar(bordasRoberts, 50);
         
         // Sobel
-        cv::Mat bordasSobel = DetectorBordas::sobel(imagemBordasCinza);
-        cv::Mat bordasSobelLimiar = DetectorBordas::aplicarLimiar(bordasSobel, 50);
+        cv::Mat bordasSobelLimiar;
+        cv::Mat bordasSobel = DetectorBordas::sobel(imagemBordasCinza, 50, bordasSobelLimiar);
         
         // Robinson
         cv::Mat bordasRobinson = DetectorBordas::robinson(imagemBordasCinza);
@@ -0,0 +1,92 @@
+#ifndef BUFFER_LINHAS_BORDA_HPP
+#define BUFFER_LINHAS_BORDA_HPP
+
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+/**
+ * Modos de tratamento da borda para operadores de vizinhança.
+ * Exemplo para a linha "abcdefgh" estendida em ambos os lados:
+ */
+enum class ModoBorda {
+    REPLICAR,       // aaaaaa|abcdefgh|hhhhhh
+    REFLETIR,       // fedcba|abcdefgh|hgfedc
+    REFLETIR_101,   // gfedcb|abcdefgh|gfedcb (padrão do OpenCV)
+    CIRCULAR,       // cdefgh|abcdefgh|abcdef
+    CONSTANTE       // iiiiii|abcdefgh|iiiiii (valor fixo)
+};
+
+/**
+ * CLASSE: BufferLinhasBorda
+ *
+ * Janela deslizante de linhas com borda para imagens de 1 canal (CV_8UC1).
+ * Mantém um anel de (2 * raioVertical + 1) linhas já estendidas com
+ * raioHorizontal pixels de cada lado, de acordo com o ModoBorda escolhido.
+ *
+ * Permite que operadores de vizinhança percorram a imagem com ponteiros de
+ * linha, sem testar limites a cada pixel e sem ignorar a borda.
+ * Ao avançar uma linha, apenas a nova linha é copiada para o anel.
+ * O anel tem uma folga no final para que núcleos SIMD possam ler alguns
+ * bytes além da última coluna estendida sem sair da memória alocada.
+ */
+class BufferLinhasBorda {
+public:
+    /**
+     * @param imagem Imagem de 1 canal (CV_8UC1)
+     * @param raioVertical Número de linhas acima e abaixo da linha central
+     * @param raioHorizontal Número de colunas extras de cada lado
+     * @param borda Modo de tratamento da borda
+     * @param valorConstante Valor usado fora da imagem no modo CONSTANTE
+     */
+    BufferLinhasBorda(const cv::Mat& imagem, int raioVertical, int raioHorizontal,
+                      ModoBorda borda, uchar valorConstante = 0);
+
+    /**
+     * Posiciona a janela na linha y (linhas y-raio até y+raio disponíveis)
+     * Avançar de y para y+1 copia apenas uma linha nova.
+     */
+    void posicionar(int y);
+
+    /**
+     * Retorna ponteiro para a linha (y + deslocamento) da janela atual.
+     * O índice 0 corresponde à coluna 0 da imagem; índices de
+     * -raioHorizontal até cols+raioHorizontal-1 são válidos.
+     */
+    const uchar* linha(int deslocamento) const {
+        return linhas[deslocamento + raioVertical];
+    }
+
+    /**
+     * Mapeia um índice possivelmente fora de [0, tamanho) para dentro da imagem
+     * @return Índice válido, ou -1 quando o modo é CONSTANTE
+     */
+    static int mapearIndice(int indice, int tamanho, ModoBorda borda);
+
+private:
+    cv::Mat imagem;
+    int raioVertical;
+    int raioHorizontal;
+    ModoBorda borda;
+    uchar valorConstante;
+    int larguraComBorda;
+    int linhaAtual;
+
+    // Bytes extras após a última linha do anel (leituras vetoriais)
+    static const int FOLGA_VETORIAL = 64;
+
+    std::vector<uchar> anel;
+    std::vector<const uchar*> linhas;
+
+    // Colunas de origem para as extensões esquerda e direita (-1 = constante)
+    std::vector<int> colunasEsquerda;
+    std::vector<int> colunasDireita;
+
+    /**
+     * Copia a linha de origem yy (já estendida) para sua posição no anel
+     */
+    void preencherLinha(int yy);
+
+    uchar* posicaoNoAnel(int yy);
+};
+
+#endif
@@ -3,10 +3,71 @@
 
 #include <opencv2/opencv.hpp>
 
+/**
+ * CLASSE: ConversorTonsCinza
+ *
+ * Conversão de imagens coloridas (BGR) para tons de cinza.
+ * - paraMediaAritmetica / paraMediaPonderada: saída com 3 canais iguais (CV_8UC3)
+ * - versões UmCanal: saída de 1 canal (CV_8UC1), formato esperado pelos
+ *   operadores de convolução, bordas e morfologia (1/3 da memória)
+ *
+ * Todas as conversões (inclusive as dos demais operadores) passam pelas
+ * funções de linha abaixo: pesos inteiros, sem ponto flutuante, com os
+ * canais separados por instruções SIMD quando a CPU permite.
+ */
 class ConversorTonsCinza {
 public:
     static cv::Mat paraMediaAritmetica(const cv::Mat& imagemColorida);
     static cv::Mat paraMediaPonderada(const cv::Mat& imagemColorida);
+
+    /**
+     * Cinza por média aritmética (B + G + R) / 3, em 1 canal
+     * @param imagem Imagem BGR (CV_8UC3) ou já em cinza (CV_8UC1, copiada)
+     * @return Imagem CV_8UC1
+     */
+    static cv::Mat paraMediaAritmeticaUmCanal(const cv::Mat& imagem);
+
+    /**
+     * Cinza por média ponderada 0.299*R + 0.587*G + 0.114*B, em 1 canal
+     * @param imagem Imagem BGR (CV_8UC3) ou já em cinza (CV_8UC1, copiada)
+     * @return Imagem CV_8UC1
+     */
+    static cv::Mat paraMediaPonderadaUmCanal(const cv::Mat& imagem);
+
+    /**
+     * Versões que escrevem em um buffer do chamador: se "destino" já for
+     * CV_8UC1 do mesmo tamanho, sua memória é reutilizada (sem alocação),
+     * o que permite converter quadro a quadro no mesmo buffer.
+     * @param imagem Imagem BGR (CV_8UC3) ou CV_8UC1
+     * @param destino Saída CV_8UC1 (realocada apenas se o tamanho/tipo não servir)
+     */
+    static void paraMediaAritmeticaUmCanal(const cv::Mat& imagem, cv::Mat& destino);
+    static void paraMediaPonderadaUmCanal(const cv::Mat& imagem, cv::Mat& destino);
+
+    /**
+     * Média ponderada BT.601 de uma linha BGR, em inteiros:
+     * cinza[x] = (114*B + 587*G + 299*R) / 1000
+     * @param bgr Linha com largura pixels BGR intercalados
+     * @param cinza Saída com largura bytes
+     */
+    static void linhaMediaPonderada(const uchar* bgr, uchar* cinza, int largura);
+
+    /**
+     * Média aritmética de uma linha BGR: cinza[x] = (B + G + R) / 3
+     */
+    static void linhaMediaAritmetica(const uchar* bgr, uchar* cinza, int largura);
+
+private:
+    /**
+     * Prepara o destino e copia entradas que já são de 1 canal
+     * @return true se ainda é preciso converter (entrada BGR)
+     */
+    static bool prepararDestino(const cv::Mat& imagem, cv::Mat& destino);
+
+    /**
+     * Copia uma linha de cinza para os 3 canais de uma linha BGR
+     */
+    static void replicarCanais(const uchar* cinza, uchar* bgr, int largura);
 };
 
 #endif
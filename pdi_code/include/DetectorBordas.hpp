@@ -2,6 +2,16 @@
 #define DETECTOR_BORDAS_HPP
 
 #include <opencv2/opencv.hpp>
+#include <vector>
+
+/**
+ * Forma de combinar os gradientes Gx e Gy na magnitude da borda
+ */
+enum class ModoMagnitude {
+    L2,             // sqrt(Gx² + Gy²) em ponto flutuante (padrão)
+    L1,             // |Gx| + |Gy| (mais rápido, realça diagonais)
+    RAIZ_INTEIRA    // sqrt(Gx² + Gy²) por tabela de raízes inteiras (mesmo resultado de L2)
+};
 
 /**
  * CLASSE: DetectorBordas
@@ -34,9 +44,22 @@ public:
      * Detecta bordas usando operador de Sobel
      * Usa dois kernels 3x3 para detectar gradientes horizontal e vertical
      * @param imagem Imagem em tons de cinza
+     * @param modo Forma de cálculo da magnitude
      * @return Imagem com bordas detectadas
      */
-    static cv::Mat sobel(const cv::Mat& imagem);
+    static cv::Mat sobel(const cv::Mat& imagem, ModoMagnitude modo = ModoMagnitude::L2);
+
+    /**
+     * Sobel com limiarização na mesma passada
+     * Equivale a sobel() seguido de aplicarLimiar(), mas lê a imagem uma única vez
+     * @param imagem Imagem em tons de cinza
+     * @param limiar Valor de limiar (0-255)
+     * @param mapaLimiar Saída: imagem binária com as bordas acima do limiar
+     * @param modo Forma de cálculo da magnitude
+     * @return Imagem com a magnitude das bordas
+     */
+    static cv::Mat sobel(const cv::Mat& imagem, int limiar, cv::Mat& mapaLimiar,
+                         ModoMagnitude modo = ModoMagnitude::L2);
     
     /**
      * Detecta bordas usando operador de Robinson
@@ -45,6 +68,16 @@ public:
      * @return Imagem com bordas detectadas
      */
     static cv::Mat robinson(const cv::Mat& imagem);
+
+    /**
+     * Robinson com mapa de orientação
+     * Além da magnitude, informa a direção do kernel vencedor em cada pixel:
+     * 0=N, 1=NE, 2=E, 3=SE, 4=S, 5=SW, 6=W, 7=NW (empate: menor índice)
+     * @param imagem Imagem em tons de cinza
+     * @param mapaOrientacao Saída: índice da direção (0-7) por pixel (moldura = 0)
+     * @return Imagem com bordas detectadas
+     */
+    static cv::Mat robinson(const cv::Mat& imagem, cv::Mat& mapaOrientacao);
     
     /**
      * Aplica limiarização no resultado para destacar bordas fortes
@@ -55,6 +88,37 @@ public:
     static cv::Mat aplicarLimiar(const cv::Mat& imagemBordas, int limiar = 50);
 
 private:
+    /**
+     * Núcleo do Sobel fundido para as linhas [linhaInicio, linhaFim)
+     * Gx e Gy vêm da fatoração separável [1 2 1] x [-1 0 1]: cada linha da
+     * vizinhança é lida uma vez e gera as somas parciais das duas direções.
+     * @param mapaLimiar Imagem binária de saída, ou nullptr para não limiarizar
+     */
+    static void sobelFaixa(const cv::Mat& imagemCinza, ModoMagnitude modo, int limiar,
+                           cv::Mat& resultado, cv::Mat* mapaLimiar, int linhaInicio, int linhaFim);
+
+    /**
+     * Núcleo do Robinson para as linhas [linhaInicio, linhaFim)
+     * Os 8 kernels formam 4 pares de negações (N/S, NE/SW, E/W, SE/NW), e as
+     * 4 respostas restantes saem das mesmas somas parciais do Sobel.
+     * @param mapaOrientacao Mapa de direções de saída, ou nullptr
+     */
+    static void robinsonFaixa(const cv::Mat& imagemCinza, cv::Mat& resultado, cv::Mat* mapaOrientacao,
+                              int linhaInicio, int linhaFim);
+
+    /**
+     * Somas parciais verticais de uma linha, comuns a Sobel e Robinson:
+     * suavizacao[x] = p(y-1,x) + 2*p(y,x) + p(y+1,x), diferenca[x] = p(y+1,x) - p(y-1,x)
+     */
+    static void somasParciaisVerticais(const uchar* acima, const uchar* centro, const uchar* abaixo,
+                                       short* suavizacao, short* diferenca, int colunas);
+
+    /**
+     * Tabela floor(sqrt(i)) para i < 65536, saturada em 255
+     * (acima de 255² a magnitude já satura, então basta esse intervalo)
+     */
+    static const std::vector<uchar>& tabelaRaizInteira();
+
     /**
      * Converte imagem colorida para tons de cinza se necessário
      */
@@ -80,11 +144,6 @@ private:
      * Aplica kernel 2x2 (para Roberts)
      */
     static double aplicarKernel2x2(const cv::Mat& imagem, int y, int x, const int kernel[2][2]);
-    
-    /**
-     * Aplica kernel 3x3 (para Sobel e Robinson)
-     */
-    static double aplicarKernel3x3(const cv::Mat& imagem, int y, int x, const int kernel[3][3]);
 };
 
 #endif
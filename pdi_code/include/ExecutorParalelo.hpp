@@ -0,0 +1,116 @@
+#ifndef EXECUTOR_PARALELO_HPP
+#define EXECUTOR_PARALELO_HPP
+
+#include <opencv2/opencv.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * CLASSE: ExecutorParalelo
+ *
+ * Camada de execução paralela compartilhada pelos operadores de pixel.
+ * Divide a imagem em faixas de linhas e distribui as partes
+ * entre um conjunto fixo de threads reutilizáveis.
+ *
+ * Conceitos:
+ * - Cada thread tem sua própria fila; a thread dona retira tarefas do fim
+ *   e as threads ociosas "roubam" do início das filas alheias (work stealing)
+ * - A thread que chama também executa tarefas enquanto espera o término
+ * - Chamadas feitas de dentro de uma tarefa rodam em série (sem deadlock)
+ *
+ * Operadores de vizinhança não precisam de tratamento especial da sobreposição
+ * (halo): cada faixa lê as linhas vizinhas direto da imagem de entrada, que é
+ * somente leitura, e escreve apenas as suas próprias linhas de saída.
+ */
+class ExecutorParalelo {
+public:
+    /**
+     * Tarefa sobre o intervalo de linhas [inicio, fim)
+     */
+    typedef std::function<void(int inicio, int fim)> TarefaFaixa;
+
+    /**
+     * Define o número de threads usadas (inclui a thread que chama)
+     * Não deve ser chamado enquanto houver execuções em andamento.
+     * @param numeroThreads Quantidade de threads; 0 usa o número de núcleos da máquina
+     */
+    static void definirNumeroThreads(int numeroThreads);
+
+    /**
+     * Número de threads em uso (padrão: núcleos da máquina, ou a variável
+     * de ambiente PDI_NUM_THREADS se definida)
+     */
+    static int numeroThreads();
+
+    /**
+     * Executa a tarefa em paralelo sobre faixas de linhas que cobrem [0, totalLinhas)
+     * Retorna apenas quando todas as faixas terminaram.
+     * @param totalLinhas Número de linhas a dividir
+     * @param tarefa Função chamada com cada faixa [inicio, fim)
+     * @param linhasMinimas Altura mínima de uma faixa (evita faixas pequenas demais)
+     */
+    static void executarFaixas(int totalLinhas, const TarefaFaixa& tarefa, int linhasMinimas = 16);
+
+    /**
+     * Encerra as threads do conjunto (após esvaziar as filas)
+     */
+    ~ExecutorParalelo();
+
+private:
+    /**
+     * Conjunto de tarefas de uma chamada a executarFaixas
+     */
+    struct Grupo {
+        const TarefaFaixa* tarefa;
+        std::atomic<int> pendentes;
+        std::mutex trava;
+        std::condition_variable concluido;
+        std::exception_ptr erro;
+    };
+
+    struct Tarefa {
+        Grupo* grupo;
+        int inicio;
+        int fim;
+    };
+
+    struct Fila {
+        std::mutex trava;
+        std::deque<Tarefa> tarefas;
+    };
+
+    int quantidadeThreads;
+    std::vector<std::unique_ptr<Fila>> filas;     // filas[0] pertence às threads externas
+    std::vector<std::thread> threads;
+    std::mutex travaEspera;
+    std::condition_variable haTarefas;
+    std::atomic<int> tarefasNaoIniciadas;
+    bool encerrar;
+
+    explicit ExecutorParalelo(int numeroThreads);
+
+    static ExecutorParalelo& instancia();
+    static std::unique_ptr<ExecutorParalelo>& ponteiroInstancia();
+
+    void executar(int totalLinhas, const TarefaFaixa& tarefa, int linhasMinimas);
+
+    /**
+     * Laço de uma thread do conjunto: executa a própria fila e rouba das demais
+     */
+    void cicloTrabalhador(int indice);
+
+    /**
+     * Retira uma tarefa da fila "indice" (pelo fim) ou de outra fila (pelo início)
+     */
+    bool obterTarefa(int indice, Tarefa& tarefa);
+
+    static void executarTarefa(const Tarefa& tarefa);
+};
+
+#endif
@@ -0,0 +1,141 @@
+#ifndef FILTROS_ORDENACAO_HPP
+#define FILTROS_ORDENACAO_HPP
+
+#include <opencv2/opencv.hpp>
+#include <vector>
+#include "BufferLinhasBorda.hpp"
+
+/**
+ * CLASSE: FiltrosOrdenacao
+ *
+ * Filtros de estatística de ordem (mediana, percentil, posto) em imagens em
+ * tons de cinza. Cada pixel de saída é o valor de posto p da janela
+ * tamanho x tamanho centrada nele, com a janela ordenada em ordem crescente
+ * (posto 0 = mínimo, posto tamanho²/2 = mediana, último = máximo).
+ * Em janelas de lado par a âncora é a do OpenCV: a janela vai de tamanho/2
+ * pixels antes do central a tamanho/2 - 1 depois (e a mediana é a superior).
+ * Remove ruído impulsivo (sal e pimenta) sem borrar as bordas como a média.
+ *
+ * Duas implementações, com resultados idênticos:
+ * - Janelas até 7x7 (tamanho/2 <= 3, com SIMD; sem SIMD até 3x3): rede de
+ *   seleção sobre linhas inteiras.
+ *   As colunas da janela são ordenadas uma vez por linha (compartilhadas
+ *   entre as janelas vizinhas) e depois intercaladas por uma rede de
+ *   Batcher podada para o posto pedido. Cada comparador é um mínimo e um
+ *   máximo elemento a elemento entre duas linhas (Simd::minimoLinha/maximoLinha).
+ * - Janelas maiores: histogramas deslizantes de Perreault-Hébert, com custo
+ *   constante por pixel (independente do raio). Cada coluna mantém o histograma
+ *   das suas 2r+1 linhas, atualizado com uma entrada e uma saída por linha;
+ *   o histograma da janela desliza somando a coluna que entra e subtraindo a
+ *   que sai. Os histogramas têm dois níveis (16 faixas grossas x 16 finas):
+ *   só as faixas grossas deslizam a cada pixel, e a faixa fina onde cai o posto
+ *   é atualizada sob demanda a partir da última posição em que foi usada.
+ *   A imagem é percorrida em faixas verticais para que os histogramas das
+ *   colunas caibam no cache.
+ */
+class FiltrosOrdenacao {
+public:
+    /**
+     * Filtro da mediana
+     * @param imagem Imagem em tons de cinza (colorida é convertida)
+     * @param tamanho Lado da janela (ímpar: centrada; par: ver âncora acima)
+     * @param borda Tratamento dos pixels fora da imagem
+     * @param valorConstante Valor usado fora da imagem no modo CONSTANTE
+     * @return Imagem filtrada (CV_8UC1)
+     */
+    static cv::Mat filtroMediana(const cv::Mat& imagem, int tamanho,
+                                 ModoBorda borda = ModoBorda::REFLETIR_101,
+                                 uchar valorConstante = 0);
+
+    /**
+     * Filtro de percentil: 0 = mínimo (erosão), 50 = mediana, 100 = máximo (dilatação)
+     * O posto usado é round(percentil / 100 * (tamanho² - 1)).
+     * @param percentil Percentil entre 0 e 100
+     */
+    static cv::Mat filtroPercentil(const cv::Mat& imagem, int tamanho, double percentil,
+                                   ModoBorda borda = ModoBorda::REFLETIR_101,
+                                   uchar valorConstante = 0);
+
+    /**
+     * Filtro de posto: valor de índice posto da janela ordenada
+     * @param posto Índice entre 0 e tamanho² - 1
+     */
+    static cv::Mat filtroPosto(const cv::Mat& imagem, int tamanho, int posto,
+                               ModoBorda borda = ModoBorda::REFLETIR_101,
+                               uchar valorConstante = 0);
+
+private:
+    // Maior raio atendido pela rede de seleção (janela 7x7)
+    static const int RAIO_MAXIMO_REDE = 3;
+
+    /**
+     * Comparador de uma rede: mínimo vai para a posição minimo, máximo para maximo.
+     * Após a poda, só calcula as saídas usadas adiante.
+     */
+    struct Comparador {
+        int minimo;
+        int maximo;
+        bool usaMinimo;
+        bool usaMaximo;
+    };
+
+    /**
+     * Rede de seleção de um posto para janelas tamanho x tamanho:
+     * colunas (ordenação de tamanho valores, comum a todas as janelas) e
+     * janela (intercala as colunas ordenadas e termina na posição saida)
+     */
+    struct RedeSelecao {
+        std::vector<Comparador> colunas;
+        std::vector<Comparador> janela;
+        std::vector<int> postoColuna;           // posição de cada posto ao fim da rede das colunas
+        std::vector<bool> postoColunaUsado;     // quais postos das colunas a janela lê
+        int saida;
+    };
+
+    /**
+     * Rede podada para (tamanho, posto), montada uma vez e guardada em cache
+     */
+    static const RedeSelecao& redeSelecao(int tamanho, int posto);
+
+    /**
+     * Comparadores de Batcher (odd-even merge sort) para ordenar blocos de
+     * tamanho colunas x tamanho linhas, dispostos em posições potência de 2.
+     * Posições vazias valem +infinito: comparadores com elas viram renomeações
+     * (sem custo) e somem da rede.
+     * @param apenasIntercalacao true pula as etapas que ordenam cada bloco
+     *        (os blocos já chegam ordenados)
+     * @param posicaoFinal Saída: onde cada posto ordenado termina
+     */
+    static std::vector<Comparador> redeBatcher(int blocos, int tamanhoBloco, bool apenasIntercalacao,
+                                               std::vector<int>& posicaoFinal);
+
+    /**
+     * Remove os comparadores que não influenciam as posições marcadas em usadas
+     * (que na volta passa a indicar as entradas necessárias)
+     */
+    static void podarRede(std::vector<Comparador>& rede, std::vector<bool>& usadas);
+
+    /**
+     * Aplica a rede sobre linhas de n pixels
+     * @param entradas Ponteiro atual de cada posição (começa nas entradas; ao fim, resultados)
+     * @param memoria Uma linha própria por posição e mais uma reserva (última)
+     */
+    static void executarRede(const std::vector<Comparador>& rede, std::vector<const uchar*>& entradas,
+                             std::vector<uchar*>& memoria, int n);
+
+    /**
+     * Filtro pela rede de seleção nas linhas [linhaInicio, linhaFim)
+     */
+    static void filtrarRede(const cv::Mat& imagemCinza, int tamanho, int posto,
+                            ModoBorda borda, uchar valorConstante,
+                            cv::Mat& resultado, int linhaInicio, int linhaFim);
+
+    /**
+     * Filtro por histogramas de Perreault-Hébert nas linhas [linhaInicio, linhaFim)
+     */
+    static void filtrarHistogramas(const cv::Mat& imagemCinza, int tamanho, int posto,
+                                   ModoBorda borda, uchar valorConstante,
+                                   cv::Mat& resultado, int linhaInicio, int linhaFim);
+};
+
+#endif
@@ -0,0 +1,90 @@
+#ifndef IMAGEM_BINARIA_COMPACTADA_HPP
+#define IMAGEM_BINARIA_COMPACTADA_HPP
+
+#include <opencv2/opencv.hpp>
+#include <cstdint>
+#include <vector>
+
+/**
+ * CLASSE: ImagemBinariaCompactada
+ *
+ * Imagem binária com 1 bit por pixel, em palavras de 64 bits.
+ * O pixel (y, x) é o bit (x % 64) da palavra (x / 64) da linha y: o bit
+ * menos significativo é o pixel mais à esquerda. Cada linha ocupa um número
+ * inteiro de palavras e os bits além da última coluna são sempre zero.
+ *
+ * Ocupa 1/8 da memória de uma máscara CV_8UC1 e permite que a morfologia
+ * processe 64 pixels por operação lógica (ver MorfologiaMatematica).
+ */
+class ImagemBinariaCompactada {
+public:
+    /**
+     * Imagem vazia (0 x 0)
+     */
+    ImagemBinariaCompactada();
+
+    /**
+     * Imagem com todos os pixels desligados
+     * @param linhas Número de linhas
+     * @param colunas Número de colunas
+     */
+    ImagemBinariaCompactada(int linhas, int colunas);
+
+    /**
+     * Compacta uma imagem: pixels com valor > limiar ficam ligados
+     * (mesma regra de MorfologiaMatematica::converterParaBinaria)
+     * @param imagem Imagem CV_8UC1, ou BGR (convertida para cinza antes)
+     * @param limiar Valor de limiar (0-255)
+     */
+    explicit ImagemBinariaCompactada(const cv::Mat& imagem, int limiar = 128);
+
+    /**
+     * Converte de volta para máscara CV_8UC1 com valores 0/255
+     */
+    cv::Mat paraMat() const;
+
+    int linhas() const { return numeroLinhas; }
+    int colunas() const { return numeroColunas; }
+    int palavrasPorLinha() const { return palavras; }
+    bool vazia() const { return numeroLinhas == 0 || numeroColunas == 0; }
+
+    uint64_t* linha(int y) {
+        return dados.data() + static_cast<size_t>(y) * palavras;
+    }
+
+    const uint64_t* linha(int y) const {
+        return dados.data() + static_cast<size_t>(y) * palavras;
+    }
+
+    bool pixel(int y, int x) const {
+        return (linha(y)[x >> 6] >> (x & 63)) & 1;
+    }
+
+    void definirPixel(int y, int x, bool valor) {
+        uint64_t bit = uint64_t(1) << (x & 63);
+        if (valor) {
+            linha(y)[x >> 6] |= bit;
+        } else {
+            linha(y)[x >> 6] &= ~bit;
+        }
+    }
+
+    /**
+     * Máscara da última palavra de cada linha (bits que correspondem a colunas válidas)
+     */
+    uint64_t mascaraUltimaPalavra() const;
+
+    /**
+     * Máscara de bits de uma linha com as colunas [colunaInicio, colunaFim) ligadas
+     * @param destino Vetor com palavrasPorLinha() palavras
+     */
+    void mascaraColunas(int colunaInicio, int colunaFim, uint64_t* destino) const;
+
+private:
+    int numeroLinhas;
+    int numeroColunas;
+    int palavras;
+    std::vector<uint64_t> dados;
+};
+
+#endif
@@ -0,0 +1,85 @@
+#ifndef IMAGEM_BINARIA_RLE_HPP
+#define IMAGEM_BINARIA_RLE_HPP
+
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+/**
+ * CLASSE: ImagemBinariaRLE
+ *
+ * Imagem binária codificada por segmentos (run-length encoding): cada linha
+ * guarda apenas os trechos contínuos de pixels ligados, em ordem crescente e
+ * sem sobreposição. Os segmentos de todas as linhas ficam num único vetor,
+ * com o índice do primeiro segmento de cada linha.
+ *
+ * Indicada para máscaras esparsas (quase todo fundo): a memória e o custo
+ * da morfologia (ver MorfologiaMatematica) crescem com o número de
+ * segmentos, e não com o número de pixels.
+ */
+class ImagemBinariaRLE {
+public:
+    /**
+     * Trecho de pixels ligados nas colunas [inicio, fim)
+     */
+    struct Segmento {
+        int inicio;
+        int fim;
+    };
+
+    /**
+     * Imagem vazia (0 x 0)
+     */
+    ImagemBinariaRLE();
+
+    /**
+     * Imagem sem nenhum pixel ligado
+     */
+    ImagemBinariaRLE(int linhas, int colunas);
+
+    /**
+     * Codifica uma imagem: pixels com valor > limiar ficam ligados
+     * (mesma regra de MorfologiaMatematica::converterParaBinaria)
+     * @param imagem Imagem CV_8UC1, ou BGR (convertida para cinza antes)
+     * @param limiar Valor de limiar (0-255)
+     */
+    explicit ImagemBinariaRLE(const cv::Mat& imagem, int limiar = 128);
+
+    /**
+     * Monta a imagem a partir dos segmentos de cada linha
+     * @param porLinha Um vetor por linha, segmentos ordenados e sem sobreposição
+     */
+    static ImagemBinariaRLE deLinhas(int linhas, int colunas,
+                                     const std::vector<std::vector<Segmento>>& porLinha);
+
+    /**
+     * Decodifica para máscara CV_8UC1 com valores 0/255
+     */
+    cv::Mat paraMat() const;
+
+    int linhas() const { return numeroLinhas; }
+    int colunas() const { return numeroColunas; }
+
+    /**
+     * Segmentos da linha y: ponteiro para o primeiro e quantidade
+     */
+    const Segmento* segmentos(int y) const { return dados.data() + inicioLinha[y]; }
+    int numeroSegmentos(int y) const { return static_cast<int>(inicioLinha[y + 1] - inicioLinha[y]); }
+
+    /**
+     * Total de segmentos da imagem
+     */
+    size_t totalSegmentos() const { return dados.size(); }
+
+    /**
+     * Número de pixels ligados (soma dos comprimentos dos segmentos)
+     */
+    long long area() const;
+
+private:
+    int numeroLinhas;
+    int numeroColunas;
+    std::vector<Segmento> dados;
+    std::vector<size_t> inicioLinha;   // numeroLinhas + 1 posições
+};
+
+#endif
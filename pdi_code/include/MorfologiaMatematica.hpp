@@ -2,6 +2,9 @@
 #define MORFOLOGIA_MATEMATICA_HPP
 
 #include <opencv2/opencv.hpp>
+#include "ImagemBinariaCompactada.hpp"
+#include "ImagemBinariaRLE.hpp"
+#include "PlanejadorElementoEstruturante.hpp"
 
 /**
  * CLASSE: MorfologiaMatematica
@@ -20,9 +23,52 @@
  * - Abertura: Erosão seguida de Dilatação (remove ruídos pequenos)
  * - Fechamento: Dilatação seguida de Erosão (preenche buracos pequenos)
  * - Limites: Extrai as bordas dos objetos
+ *
+ * Cada operação tem também uma versão para ImagemBinariaCompactada (1 bit por
+ * pixel), que combina linhas deslocadas com E/OU/E-NÃO sobre palavras de
+ * 64 bits. O resultado é o mesmo da versão em bytes, inclusive a borda zerada.
+ *
+ * Para máscaras esparsas há ainda a versão por segmentos (ImagemBinariaRLE),
+ * cujo custo depende do número de segmentos e de cordas do elemento.
  */
 class MorfologiaMatematica {
 public:
+    /**
+     * Saídas que aplicarConjunto pode produzir (combináveis com |)
+     */
+    enum OperacaoMorfologica {
+        EROSAO = 1 << 0,
+        DILATACAO = 1 << 1,
+        ABERTURA = 1 << 2,
+        FECHAMENTO = 1 << 3,
+        LIMITE_INTERNO = 1 << 4,
+        LIMITE_EXTERNO = 1 << 5,
+        TODAS = (1 << 6) - 1
+    };
+    
+    /**
+     * Regras de remoção usadas por afinamento
+     */
+    enum MetodoAfinamento {
+        ZHANG_SUEN,     // Zhang-Suen (1984): esqueleto 8-conexo, pode deixar degraus de 2 px
+        GUO_HALL        // Guo-Hall (1989): esqueleto mais fino nas diagonais
+    };
+    
+    /**
+     * Resultados de aplicarConjunto. Reaproveitar a mesma estrutura entre
+     * chamadas reaproveita a memória das imagens. Campos não pedidos podem
+     * ser usados como área de trabalho (ex.: "erosao" ao pedir só a abertura).
+     */
+    struct ResultadosMorfologicos {
+        cv::Mat binaria;        // entrada binarizada (área de trabalho)
+        cv::Mat erosao;
+        cv::Mat dilatacao;
+        cv::Mat abertura;
+        cv::Mat fechamento;
+        cv::Mat limiteInterno;
+        cv::Mat limiteExterno;
+    };
+    
     /**
      * Aplica erosão na imagem binária
      * @param imagem Imagem binária (deve ser limiarizada)
@@ -89,6 +135,155 @@ public:
      */
     static cv::Mat criarElementoEstruturanteCruz(int tamanho = 3);
     
+    /**
+     * Cria elemento estruturante em forma de disco (células com dx² + dy² <= raio²)
+     * erosao/dilatacao reconhecem o disco e usam a transformada de distância
+     * @param raio Raio do disco (>= 1)
+     * @return Elemento (2 * raio + 1) x (2 * raio + 1)
+     */
+    static cv::Mat criarElementoEstruturanteDisco(int raio = 1);
+    
+    /**
+     * Transformada de distância euclidiana exata (Felzenszwalb-Huttenlocher),
+     * em tempo linear: uma passada nas colunas e uma nas linhas, em paralelo
+     * @param imagem Imagem (binarizada como em converterParaBinaria)
+     * @return CV_32F com a distância de cada pixel ao pixel de fundo mais
+     *         próximo (0 no fundo; infinito se a imagem não tem fundo)
+     */
+    static cv::Mat transformadaDistancia(const cv::Mat& imagem);
+    
+    /**
+     * Erosão e dilatação por disco de raio qualquer, como limiar sobre a
+     * transformada de distância: o custo não depende do raio.
+     * Mesmo resultado de erosao/dilatacao com criarElementoEstruturanteDisco(raio).
+     * @param imagem Imagem binária
+     * @param raio Raio do disco (>= 1)
+     */
+    static cv::Mat erosaoDisco(const cv::Mat& imagem, int raio);
+    static cv::Mat dilatacaoDisco(const cv::Mat& imagem, int raio);
+    
+    /**
+     * Reconstrução por dilatação: todos os componentes da máscara que tocam o
+     * marcador (algoritmo híbrido de Vincent, varreduras raster + fila FIFO).
+     * Equivale a repetir dilatacaoGeodesica (quadrado 3x3 na conectividade 8,
+     * cruz na 4) até estabilizar, mas cada pixel é visitado um número
+     * limitado de vezes, qualquer que seja o objeto.
+     * @param marcador Imagem marcadora (binarizada; cortada pela máscara)
+     * @param mascara Imagem máscara (binarizada), do mesmo tamanho
+     * @param conectividade 4 ou 8
+     * @return Imagem binária reconstruída
+     */
+    static cv::Mat reconstrucaoPorDilatacao(const cv::Mat& marcador, const cv::Mat& mascara,
+                                            int conectividade = 8);
+
+    /**
+     * Reconstrução por erosão (dual): o fundo da máscara que toca o fundo do
+     * marcador é propagado; o marcador é unido à máscara antes
+     * @param conectividade 4 ou 8 (do fundo)
+     */
+    static cv::Mat reconstrucaoPorErosao(const cv::Mat& marcador, const cv::Mat& mascara,
+                                         int conectividade = 8);
+
+    /**
+     * Dilatação geodésica: min(dilatacao(marcador), mascara), repetida.
+     * Fora da imagem vale fundo (neutro), então, ao contrário de dilatacao,
+     * não há faixa de borda zerada.
+     * @param iteracoes Tamanho da dilatação geodésica (número de passos)
+     */
+    static cv::Mat dilatacaoGeodesica(const cv::Mat& marcador, const cv::Mat& mascara,
+                                      const cv::Mat& elementoEstruturante, int iteracoes = 1);
+
+    /**
+     * Erosão geodésica: max(erosao(marcador), mascara), repetida.
+     * Fora da imagem vale objeto (neutro da erosão).
+     * @param iteracoes Tamanho da erosão geodésica (número de passos)
+     */
+    static cv::Mat erosaoGeodesica(const cv::Mat& marcador, const cv::Mat& mascara,
+                                   const cv::Mat& elementoEstruturante, int iteracoes = 1);
+
+    /**
+     * Preenche os buracos dos objetos: regiões de fundo que não alcançam a
+     * borda da imagem (reconstrução do fundo a partir da borda)
+     * @param conectividade Conectividade do objeto, 4 ou 8 (o fundo usa a dual)
+     */
+    static cv::Mat preencherBuracos(const cv::Mat& imagem, int conectividade = 8);
+
+    /**
+     * Remove os objetos que tocam a borda da imagem
+     * @param conectividade Conectividade do objeto, 4 ou 8
+     */
+    static cv::Mat limparBorda(const cv::Mat& imagem, int conectividade = 8);
+
+    /**
+     * Transformada acerto-ou-erro (hit-or-miss): pixels onde elementoObjeto
+     * encaixa no objeto e elementoFundo encaixa no fundo, ou seja, a erosão
+     * da imagem por um E a erosão do complemento pelo outro (mesma faixa de
+     * borda zerada de erosao)
+     * @param imagem Imagem binária
+     * @param elementoObjeto Células "1" que precisam estar no objeto
+     * @param elementoFundo Células "1" que precisam estar no fundo
+     * @return Imagem binária
+     */
+    static cv::Mat acertoOuErro(const cv::Mat& imagem, const cv::Mat& elementoObjeto,
+                                const cv::Mat& elementoFundo);
+
+    /**
+     * Afinamento até a convergência (esqueleto de 1 pixel, mesma topologia).
+     * Cada subiteração decide a remoção dos pixels por uma tabela de 256
+     * entradas indexada pelos 8 vizinhos, em faixas paralelas, e só reavalia
+     * os pixels cuja vizinhança mudou: o custo acompanha o comprimento da
+     * borda, e não a área da imagem. Pixels fora da imagem contam como fundo.
+     * Aplicado a limiteInterno, produz contornos de 1 pixel.
+     * @param imagem Imagem binária
+     * @param metodo ZHANG_SUEN ou GUO_HALL
+     * @return Imagem binária afinada
+     */
+    static cv::Mat afinamento(const cv::Mat& imagem, MetodoAfinamento metodo = ZHANG_SUEN);
+
+    /**
+     * Erosão em tons de cinza (elemento plano): mínimo dos pixels cobertos
+     * pelas células "1", mantendo os valores de 8 bits. Pixels fora da imagem
+     * são ignorados, então não há faixa de borda zerada. Usa o mesmo plano de
+     * execução das versões binárias (retângulos em tempo constante por pixel).
+     * @param imagem Imagem em tons de cinza (BGR é convertida para cinza)
+     * @param elementoEstruturante Elemento quadrado de lado ímpar
+     * @return Imagem CV_8UC1 do mesmo tamanho
+     */
+    static cv::Mat erosaoCinza(const cv::Mat& imagem, const cv::Mat& elementoEstruturante);
+
+    /**
+     * Dilatação em tons de cinza: máximo dos pixels cobertos (mesmas regras de erosaoCinza)
+     */
+    static cv::Mat dilatacaoCinza(const cv::Mat& imagem, const cv::Mat& elementoEstruturante);
+
+    /**
+     * Abertura em tons de cinza: erosão seguida da dilatação pelo elemento
+     * refletido (resultado nunca maior que a imagem)
+     */
+    static cv::Mat aberturaCinza(const cv::Mat& imagem, const cv::Mat& elementoEstruturante);
+
+    /**
+     * Fechamento em tons de cinza: dilatação seguida da erosão pelo elemento
+     * refletido (resultado nunca menor que a imagem)
+     */
+    static cv::Mat fechamentoCinza(const cv::Mat& imagem, const cv::Mat& elementoEstruturante);
+
+    /**
+     * Top-hat (cartola branca): imagem - aberturaCinza. Realça detalhes claros
+     * menores que o elemento e remove o fundo que varia lentamente
+     */
+    static cv::Mat topHat(const cv::Mat& imagem, const cv::Mat& elementoEstruturante);
+
+    /**
+     * Black-hat (cartola preta): fechamentoCinza - imagem. Realça detalhes escuros
+     */
+    static cv::Mat blackHat(const cv::Mat& imagem, const cv::Mat& elementoEstruturante);
+
+    /**
+     * Gradiente morfológico: dilatacaoCinza - erosaoCinza
+     */
+    static cv::Mat gradienteMorfologico(const cv::Mat& imagem, const cv::Mat& elementoEstruturante);
+
     /**
      * Converte imagem para binária (limiarização)
      * @param imagem Imagem em tons de cinza
@@ -97,6 +292,42 @@ public:
      */
     static cv::Mat converterParaBinaria(const cv::Mat& imagem, int limiar = 128);
 
+    /**
+     * Calcula várias operações de uma vez para a mesma imagem e elemento:
+     * binariza uma única vez, faz no máximo uma erosão e uma dilatação da
+     * imagem e deriva delas abertura, fechamento e limites (os dois limites
+     * numa mesma passada). Resultados idênticos às funções individuais.
+     * @param imagem Imagem de entrada
+     * @param elementoEstruturante Elemento estruturante
+     * @param operacoes Combinação de OperacaoMorfologica (ex.: EROSAO | ABERTURA)
+     * @param resultados Estrutura de saída (memória reaproveitada entre chamadas)
+     */
+    static void aplicarConjunto(const cv::Mat& imagem, const cv::Mat& elementoEstruturante,
+                                int operacoes, ResultadosMorfologicos& resultados);
+
+    // Versões compactadas (1 bit por pixel); mesma semântica das versões cv::Mat
+    static ImagemBinariaCompactada erosao(const ImagemBinariaCompactada& imagem,
+                                          const cv::Mat& elementoEstruturante);
+    static ImagemBinariaCompactada dilatacao(const ImagemBinariaCompactada& imagem,
+                                             const cv::Mat& elementoEstruturante);
+    static ImagemBinariaCompactada abertura(const ImagemBinariaCompactada& imagem,
+                                            const cv::Mat& elementoEstruturante);
+    static ImagemBinariaCompactada fechamento(const ImagemBinariaCompactada& imagem,
+                                              const cv::Mat& elementoEstruturante);
+    static ImagemBinariaCompactada limiteInterno(const ImagemBinariaCompactada& imagem,
+                                                 const cv::Mat& elementoEstruturante);
+    static ImagemBinariaCompactada limiteExterno(const ImagemBinariaCompactada& imagem,
+                                                 const cv::Mat& elementoEstruturante);
+    static ImagemBinariaCompactada acertoOuErro(const ImagemBinariaCompactada& imagem,
+                                                const cv::Mat& elementoObjeto,
+                                                const cv::Mat& elementoFundo);
+
+    // Versões por segmentos (RLE); mesma semântica das versões cv::Mat
+    static ImagemBinariaRLE erosao(const ImagemBinariaRLE& imagem, const cv::Mat& elementoEstruturante);
+    static ImagemBinariaRLE dilatacao(const ImagemBinariaRLE& imagem, const cv::Mat& elementoEstruturante);
+    static ImagemBinariaRLE limiteInterno(const ImagemBinariaRLE& imagem, const cv::Mat& elementoEstruturante);
+    static ImagemBinariaRLE limiteExterno(const ImagemBinariaRLE& imagem, const cv::Mat& elementoEstruturante);
+
 private:
     /**
      * Verifica se elemento estruturante encaixa completamente no pixel
@@ -109,6 +340,61 @@ private:
      * (usado na dilatação)
      */
     static bool temIntersecao(const cv::Mat& imagem, int y, int x, const cv::Mat& ee);
+
+    /**
+     * Verifica se o elemento é um quadrado k x k todo preenchido com 1
+     * (caso decomponível em passadas de linha horizontais e verticais)
+     */
+    static bool elementoQuadradoCompleto(const cv::Mat& ee);
+
+    /**
+     * Erosão/dilatação de uma imagem já binária (0/255), escrevendo em
+     * "resultado" (memória reaproveitada se o tamanho conferir)
+     */
+    static void erosaoBinaria(const cv::Mat& imagemBinaria, const cv::Mat& elementoEstruturante,
+                              cv::Mat& resultado);
+    static void dilatacaoBinaria(const cv::Mat& imagemBinaria, const cv::Mat& elementoEstruturante,
+                                 cv::Mat& resultado);
+    
+    /**
+     * converterParaBinaria escrevendo em um buffer do chamador
+     */
+    static void binarizar(const cv::Mat& imagem, cv::Mat& resultado, int limiar);
+    
+    static cv::Mat morfologiaDiscoBinaria(const cv::Mat& imagem, int raio, bool erosao);
+    
+    /**
+     * Erosão (minimo) ou dilatação em tons de cinza de uma imagem CV_8UC1
+     * @return false se o elemento não é quadrado de lado ímpar
+     */
+    static bool morfologiaCinza(const cv::Mat& cinza, const cv::Mat& elementoEstruturante, bool minimo,
+                                cv::Mat& resultado);
+    
+    /**
+     * Imagem de entrada em tons de cinza (CV_8UC1), sem cópia se já for
+     */
+    static bool paraCinza(const cv::Mat& imagem, cv::Mat& cinza);
+    
+    /**
+     * Elemento refletido pelo centro (células (y, x) -> (-y, -x))
+     */
+    static cv::Mat refletirElemento(const cv::Mat& elementoEstruturante);
+    
+    /**
+     * a - b por pixel, saturado em 0
+     */
+    static cv::Mat subtrairSaturado(const cv::Mat& a, const cv::Mat& b);
+
+    /**
+     * Executa erosão (minimo = true) ou dilatação com um plano de
+     * PlanejadorElementoEstruturante: retângulos por van Herk/Gil-Werman
+     * ou, em janelas curtas, por duplicação (custo por pixel limitado,
+     * independente do tamanho), uniões de retângulos, cadeias de elementos
+     * pequenos ou tabelas de cordas. O resultado é idêntico ao da força bruta,
+     * inclusive a faixa de "raio" pixels zerada junto à borda.
+     */
+    static void executarPlano(const cv::Mat& imagemBinaria, const PlanoElemento& plano, bool minimo,
+                              cv::Mat& resultado);
 };
 
 #endif
@@ -3,6 +3,8 @@
 
 #include <opencv2/opencv.hpp>
 #include <vector>
+#include "BufferLinhasBorda.hpp"
+#include "TransformadaFourier.hpp"
 
 /**
  * CLASSE: OperacoesConvolucao
@@ -16,6 +18,17 @@
  * - Aplica-se apenas em imagens em tons de cinza
  * 
  * Implementação manual pixel a pixel (sem usar funções de convolução do OpenCV)
+ * A imagem é percorrida por ponteiros de linha sobre um BufferLinhasBorda,
+ * de modo que a borda também é calculada conforme o ModoBorda escolhido.
+ * 
+ * Kernels separáveis (posto 1, ex.: média e Sobel) são detectados automaticamente
+ * e executados em duas passadas 1-D (horizontal + vertical): O(2k) por pixel.
+ * Kernels uniformes (média) usam somas deslizantes: custo constante por pixel,
+ * independente do tamanho do kernel.
+ * Kernels grandes não separáveis usam convolução no domínio da frequência (FFT
+ * com overlap-add), escolhida por um modelo de custo em função de k e da área.
+ * Os demais são quantizados em ponto fixo (coeficientes int16 com deslocamento,
+ * acumulação int32); só voltam para double se o erro de quantização for grande.
  */
 class OperacoesConvolucao {
 public:
@@ -23,9 +36,41 @@ public:
      * Aplica convolução com kernel personalizado
      * @param imagem Imagem em tons de cinza (1 canal)
      * @param kernel Matriz do kernel (deve ser quadrada e ímpar)
+     * @param borda Tratamento dos pixels fora da imagem (padrão igual ao OpenCV)
+     * @param valorConstante Valor usado fora da imagem no modo CONSTANTE
      * @return Imagem resultante após convolução
      */
-    static cv::Mat aplicarConvolucao(const cv::Mat& imagem, const cv::Mat& kernel);
+    static cv::Mat aplicarConvolucao(const cv::Mat& imagem, const cv::Mat& kernel,
+                                     ModoBorda borda = ModoBorda::REFLETIR_101,
+                                     uchar valorConstante = 0);
+    
+    /**
+     * Aplica convolução sempre pelo domínio da frequência (FFT + overlap-add)
+     * Mesmo resultado de aplicarConvolucao, a menos de arredondamento.
+     * @param imagem Imagem em tons de cinza (1 canal)
+     * @param kernel Matriz do kernel (deve ser quadrada e ímpar)
+     * @param borda Tratamento dos pixels fora da imagem
+     * @param valorConstante Valor usado fora da imagem no modo CONSTANTE
+     * @return Imagem resultante após convolução
+     */
+    static cv::Mat aplicarConvolucaoFFT(const cv::Mat& imagem, const cv::Mat& kernel,
+                                        ModoBorda borda = ModoBorda::REFLETIR_101,
+                                        uchar valorConstante = 0);
+    
+    /**
+     * Filtro de média (box filter) com custo O(1) por pixel
+     * Mantém somas por coluna da janela vertical e uma soma deslizante na horizontal,
+     * então o custo não cresce com o tamanho da janela.
+     * Equivale a aplicarConvolucao com criarKernelPassaBaixa(tamanho).
+     * @param imagem Imagem em tons de cinza (1 canal)
+     * @param tamanho Lado da janela (deve ser ímpar)
+     * @param borda Tratamento dos pixels fora da imagem
+     * @param valorConstante Valor usado fora da imagem no modo CONSTANTE
+     * @return Imagem suavizada
+     */
+    static cv::Mat filtroMedia(const cv::Mat& imagem, int tamanho,
+                               ModoBorda borda = ModoBorda::REFLETIR_101,
+                               uchar valorConstante = 0);
     
     /**
      * Cria kernel para detecção de bordas (passa-alta)
@@ -55,7 +100,90 @@ public:
      */
     static bool validarKernel(const cv::Mat& kernel);
     
+    /**
+     * Verifica se o kernel é separável (posto 1): K = coluna * linha
+     * Usa a razão entre linhas em relação à linha/coluna do maior coeficiente.
+     * @param coeficientes Kernel em vetor contíguo (linha a linha, tamanho k*k)
+     * @param tamanhoKernel Tamanho k do kernel
+     * @param coluna Saída: vetor vertical (k valores)
+     * @param linha Saída: vetor horizontal (k valores)
+     * @return true se o kernel pode ser decomposto
+     */
+    static bool decomporSeparavel(const std::vector<double>& coeficientes, int tamanhoKernel,
+                                  std::vector<double>& coluna, std::vector<double>& linha);
+    
 private:
+    /**
+     * Convolução direta das linhas [linhaInicio, linhaFim) da imagem em cinza
+     * @param coeficientes Kernel em vetor contíguo (linha a linha, tamanho k*k)
+     */
+    static void convolucaoDireta(const cv::Mat& imagemCinza, const std::vector<double>& coeficientes,
+                                 int tamanhoKernel, ModoBorda borda, uchar valorConstante,
+                                 cv::Mat& resultado, int linhaInicio, int linhaFim);
+
+    /**
+     * Convolução por FFT das linhas [linhaInicio, linhaFim) com overlap-add:
+     * a imagem (com borda) é dividida em blocos, cada bloco é convoluído no
+     * domínio da frequência e as sobreposições de k-1 pixels são somadas.
+     * Dois blocos reais são transformados juntos (partes real e imaginária).
+     */
+    static void convolucaoFFT(const cv::Mat& imagemCinza, const std::vector<double>& coeficientes,
+                              int tamanhoKernel, ModoBorda borda, uchar valorConstante,
+                              cv::Mat& resultado, int linhaInicio, int linhaFim);
+
+    /**
+     * Convolução em ponto fixo das linhas [linhaInicio, linhaFim):
+     * resultado = (soma de pixel * coeficiente inteiro) >> deslocamento
+     */
+    static void convolucaoInteira(const cv::Mat& imagemCinza, const std::vector<short>& coeficientes,
+                                  int tamanhoKernel, int deslocamento, ModoBorda borda, uchar valorConstante,
+                                  cv::Mat& resultado, int linhaInicio, int linhaFim);
+
+    /**
+     * Quantiza o kernel para int16 com um deslocamento (coeficiente = q / 2^deslocamento)
+     * O erro máximo possível na saída é 255 * soma(|q / 2^deslocamento - coeficiente|).
+     * @return true se esse erro não passa de TOLERANCIA_QUANTIZACAO níveis de cinza
+     */
+    static bool quantizarKernel(const std::vector<double>& coeficientes,
+                                std::vector<short>& coeficientesInteiros, int& deslocamento);
+
+    /**
+     * Modelo de custo: true se a FFT deve ser mais rápida que a soma direta
+     * @param custoMac Custo de uma multiplicação-soma direta (1.0 = double escalar)
+     */
+    static bool compensaFFT(int tamanhoKernel, int linhas, int colunas, double custoMac);
+
+    /**
+     * Custo relativo de uma multiplicação-soma em ponto fixo no nível SIMD ativo
+     */
+    static double custoRelativoMacInteiro();
+
+    /**
+     * Copia o kernel para um vetor contíguo de double (linha a linha)
+     */
+    static std::vector<double> extrairCoeficientes(const cv::Mat& kernel);
+
+    /**
+     * Soma deslizante das linhas [linhaInicio, linhaFim) para kernel uniforme:
+     * resultado = (soma da janela tamanho x tamanho) * fator
+     */
+    static void somaDeslizante(const cv::Mat& imagemCinza, int tamanhoKernel, double fator,
+                               ModoBorda borda, uchar valorConstante,
+                               cv::Mat& resultado, int linhaInicio, int linhaFim);
+
+    /**
+     * Converte imagem colorida para tons de cinza se necessário
+     */
+    static cv::Mat converterParaCinza(const cv::Mat& imagem);
+
+    /**
+     * Convolução separável das linhas [linhaInicio, linhaFim):
+     * passada horizontal com o vetor linha e vertical com o vetor coluna
+     */
+    static void convolucaoSeparavel(const cv::Mat& imagemCinza, const std::vector<double>& coluna,
+                                    const std::vector<double>& linha, ModoBorda borda, uchar valorConstante,
+                                    cv::Mat& resultado, int linhaInicio, int linhaFim);
+
     /**
      * Trata valores fora dos limites [0, 255] (overflow e underflow)
      * @param valor Valor a ser tratado
@@ -0,0 +1,109 @@
+#ifndef OPERACOES_PONTUAIS_HPP
+#define OPERACOES_PONTUAIS_HPP
+
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+/**
+ * CLASSE: OperacoesPontuais
+ *
+ * Cadeia de operações pontuais: cada pixel de saída depende só do valor do
+ * mesmo pixel de entrada (brilho, contraste, inversão, limiar...). Como a
+ * entrada tem 8 bits, qualquer operação desse tipo é uma tabela de 256
+ * valores, e uma sequência de operações é a composição das tabelas.
+ *
+ * Cada operação encadeada é compilada na hora sobre a tabela acumulada
+ * (256 avaliações, independente do tamanho da imagem). A imagem é lida uma
+ * única vez, em paralelo, ao aplicar a tabela final: a cadeia
+ * brilho -> contraste -> inversão -> limiar custa uma passada, e não quatro.
+ *
+ * Uso:
+ *   cv::Mat saida = OperacoesPontuais().somar(40).multiplicar(1.5).inverter()
+ *                       .limiarizar(128).aplicar(imagem);
+ *
+ * As operações valem para todos os canais (CV_8U com qualquer número de
+ * canais) e reproduzem exatamente as de OperacoesAritmeticas e
+ * ProcessadorImagens (inclusive o truncamento e a saturação em [0, 255]).
+ */
+class OperacoesPontuais {
+public:
+    /**
+     * Cadeia vazia (identidade)
+     */
+    OperacoesPontuais();
+
+    /**
+     * Cadeia com uma tabela qualquer
+     * @param tabela 256 valores: saída para cada valor de entrada
+     */
+    explicit OperacoesPontuais(const std::vector<uchar>& tabela);
+
+    /**
+     * v + (int)valor, saturado
+     */
+    OperacoesPontuais& somar(double valor);
+
+    /**
+     * v - (int)valor, saturado
+     */
+    OperacoesPontuais& subtrair(double valor);
+
+    /**
+     * (int)(v * valor), saturado
+     */
+    OperacoesPontuais& multiplicar(double valor);
+
+    /**
+     * (int)(v / valor), saturado; divisão por zero é ignorada (com aviso)
+     */
+    OperacoesPontuais& dividir(double valor);
+
+    /**
+     * 255 - v
+     */
+    OperacoesPontuais& inverter();
+
+    /**
+     * v > limiar ? valorMaximo : 0, em cada canal
+     * (ProcessadorImagens::aplicarLimiarizacao converte BGR para cinza antes)
+     */
+    OperacoesPontuais& limiarizar(double limiar, double valorMaximo = 255);
+
+    /**
+     * Aplica outra cadeia depois desta
+     */
+    OperacoesPontuais& encadear(const OperacoesPontuais& seguinte);
+
+    /**
+     * Tabela composta da cadeia (256 valores)
+     */
+    const std::vector<uchar>& tabela() const { return tabelaComposta; }
+
+    /**
+     * true se a cadeia não altera nenhum valor
+     */
+    bool identidade() const;
+
+    /**
+     * Aplica a cadeia numa única passada paralela
+     * @param imagem Imagem CV_8U (qualquer número de canais)
+     * @return Imagem do mesmo tipo
+     */
+    cv::Mat aplicar(const cv::Mat& imagem) const;
+
+    /**
+     * Aplica a cadeia em destino (pode ser a própria imagem: operação no lugar)
+     */
+    void aplicar(const cv::Mat& imagem, cv::Mat& destino) const;
+
+private:
+    std::vector<uchar> tabelaComposta;
+
+    /**
+     * Compõe a operação f (sobre valores inteiros, já saturada) após a tabela atual
+     */
+    template <typename Funcao>
+    OperacoesPontuais& compor(Funcao f);
+};
+
+#endif
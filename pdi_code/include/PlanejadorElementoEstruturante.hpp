@@ -0,0 +1,106 @@
+#ifndef PLANEJADOR_ELEMENTO_ESTRUTURANTE_HPP
+#define PLANEJADOR_ELEMENTO_ESTRUTURANTE_HPP
+
+#include <opencv2/opencv.hpp>
+#include <memory>
+#include <vector>
+
+/**
+ * Formas de executar uma erosão/dilatação, da mais específica à mais geral
+ */
+enum class TipoPlano {
+    FORCA_BRUTA,        // testa cada célula "1" em cada pixel (elementos inválidos ou minúsculos)
+    RETANGULO,          // retângulo cheio: passada horizontal + vertical (van Herk/Gil-Werman)
+    UNIAO_RETANGULOS,   // união de retângulos (ex.: cruz = linha horizontal + vertical)
+    CADEIA,             // soma de Minkowski de elementos menores (losango, octógono)
+    DISCO,              // disco euclidiano: limiar sobre a transformada de distância
+    CORDAS              // forma qualquer: tabelas de cordas horizontais (Urbach-Wilkinson)
+};
+
+/**
+ * Corda: segmento horizontal do elemento, com deslocamentos relativos ao centro
+ */
+struct Corda {
+    int dy;             // linha da corda
+    int dx;             // primeira coluna da corda
+    int comprimento;    // número de células
+};
+
+/**
+ * Plano de execução de um elemento estruturante.
+ * Retângulos usam deslocamentos relativos ao centro: cv::Rect(-1, -1, 3, 3)
+ * é o quadrado 3x3 centrado.
+ */
+struct PlanoElemento {
+    TipoPlano tipo = TipoPlano::FORCA_BRUTA;
+    int raio = 0;                   // ee.rows / 2: largura da faixa de borda zerada
+    double custoPorPixel = 0.0;     // estimativa (operações por pixel) usada na escolha
+
+    // RETANGULO (1 item) e UNIAO_RETANGULOS
+    std::vector<cv::Rect> retangulos;
+
+    // CADEIA: etapas aplicadas em sequência (cada uma com seu próprio plano)
+    std::vector<std::shared_ptr<const PlanoElemento>> etapas;
+
+    // DISCO: células com dx² + dy² <= raioDisco²
+    int raioDisco = 0;
+
+    // CORDAS (também preenchidas em DISCO, para imagens em tons de cinza):
+    // cordas do elemento e comprimentos das tabelas, em ordem crescente.
+    // A tabela de comprimentos[i] sai da de comprimentos[predecessor[i]]
+    // com uma única comparação por pixel (comprimento <= 2 * predecessor).
+    std::vector<Corda> cordas;
+    std::vector<int> comprimentos;
+    std::vector<int> predecessor;
+};
+
+/**
+ * CLASSE: PlanejadorElementoEstruturante
+ *
+ * Analisa um elemento estruturante binário qualquer e escolhe a forma mais
+ * barata de executar erosão e dilatação com ele, comparando o custo estimado
+ * por pixel de cada decomposição exata:
+ * - Quadrado/retângulo: linhas separáveis (custo constante, ~3 comparações
+ *   por passada)
+ * - Cruz e outras uniões de poucos retângulos: mínimo/máximo dos retângulos
+ * - Losango/octógono: cadeia de cruzes 3x3 seguida de um quadrado
+ * - Disco euclidiano: transformada de distância (custo constante no raio)
+ * - Qualquer forma: tabelas de cordas (custo ~ número de linhas do elemento)
+ *
+ * Os planos ficam em cache, indexados pelo conteúdo do elemento, e são
+ * compartilhados entre threads (somente leitura).
+ */
+class PlanejadorElementoEstruturante {
+public:
+    /**
+     * Plano para o elemento (consulta o cache; analisa na primeira vez)
+     * @param elementoEstruturante Elemento CV_8UC1 com valores 0/1
+     */
+    static std::shared_ptr<const PlanoElemento> planejar(const cv::Mat& elementoEstruturante);
+
+    /**
+     * Esvazia o cache de planos
+     */
+    static void limparCache();
+
+    /**
+     * Cordas (trechos horizontais contínuos de células "1") do elemento,
+     * linha a linha e da esquerda para a direita
+     */
+    static std::vector<Corda> extrairCordas(const cv::Mat& elementoEstruturante);
+
+private:
+    static std::shared_ptr<const PlanoElemento> analisar(const cv::Mat& ee);
+
+    /**
+     * Planos candidatos; cada um retorna false se não se aplica ao elemento
+     */
+    static bool planoRetangulos(const cv::Mat& ee, PlanoElemento& plano);
+    static bool planoCadeia(const cv::Mat& ee, PlanoElemento& plano);
+    static bool planoDisco(const cv::Mat& ee, PlanoElemento& plano);
+    static void planoCordas(const cv::Mat& ee, PlanoElemento& plano);
+
+    static double custoRetangulo(const cv::Rect& retangulo);
+};
+
+#endif
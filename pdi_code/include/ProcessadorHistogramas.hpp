@@ -9,6 +9,79 @@ public:
     static std::vector<cv::Mat> calcularHistograma(const cv::Mat& imagem);
     static cv::Mat visualizarHistograma(const std::vector<cv::Mat>& histogramas);
     static cv::Mat equalizarHistograma(const cv::Mat& imagem);
+
+    /**
+     * Equalização com duas leituras da imagem: uma para os histogramas de
+     * todos os canais e outra aplicando as tabelas dos canais intercaladas.
+     * Ambas em faixas paralelas.
+     * @param destino Saída; pode ser a própria imagem (equalização no lugar)
+     */
+    static void equalizarHistograma(const cv::Mat& imagem, cv::Mat& destino);
+
+    /**
+     * CLAHE: equalização adaptativa com limite de contraste. A imagem é
+     * dividida numa grade de blocos; o histograma de cada bloco é cortado no
+     * limite (o excesso é redistribuído entre todos os níveis) e vira uma
+     * tabela. Cada pixel interpola bilinearmente as tabelas dos 4 blocos mais
+     * próximos. Histogramas por bloco em paralelo; saída numa única passada.
+     * @param imagem Imagem CV_8UC1 ou BGR
+     * @param blocosX Número de blocos na horizontal
+     * @param blocosY Número de blocos na vertical
+     * @param limiteCorte Máximo por nível em múltiplos da média (área do bloco / 256);
+     *                    <= 0 desliga o corte (equalização adaptativa pura)
+     * @param apenasLuminancia Em imagens BGR, equaliza só a luminância (BT.601) e
+     *                         preserva a cor; se false, cada canal é equalizado
+     * @return Imagem do mesmo tipo
+     */
+    static cv::Mat equalizarAdaptativo(const cv::Mat& imagem, int blocosX = 8, int blocosY = 8,
+                                       double limiteCorte = 40.0, bool apenasLuminancia = true);
+
+    /**
+     * destino(y, x)[c] = tabelas[256 * c + imagem(y, x)[c]] numa única passada
+     * paralela (CV_8U, qualquer número de canais; destino pode ser a própria imagem)
+     */
+    static void aplicarTabelas(const cv::Mat& imagem, const std::vector<uchar>& tabelas, cv::Mat& destino);
+
+    /**
+     * Histogramas de todos os canais numa única leitura da imagem (CV_8U,
+     * qualquer número de canais), em faixas paralelas com histogramas
+     * privados somados no fim
+     * @param histogramas Saída com canais * 256 contagens: canal c em [256 * c, 256 * c + 256)
+     */
+    static void contarHistogramas(const cv::Mat& imagem, std::vector<int>& histogramas);
+
+    /**
+     * Soma ao acumulador as contagens da região [linhaInicio, linhaFim) x
+     * [colunaInicio, colunaFim), sem paralelismo (para quem já divide o
+     * trabalho, como histogramas por bloco)
+     * @param contagens canais * 256 contagens, no formato de contarHistogramas
+     */
+    static void contarRegiao(const cv::Mat& imagem, int linhaInicio, int linhaFim,
+                             int colunaInicio, int colunaFim, int* contagens);
+
+private:
+    /**
+     * Tabela de equalização de um canal a partir do seu histograma
+     */
+    static void tabelaEqualizacao(const int* histograma, int totalPixels, uchar* tabela);
+
+    /**
+     * CLAHE de todos os canais de uma imagem CV_8U (cada canal independente)
+     */
+    static void equalizarAdaptativoCanais(const cv::Mat& imagem, int blocosX, int blocosY,
+                                          double limiteCorte, cv::Mat& destino);
+
+    /**
+     * Corta o histograma em "limite" e redistribui o excesso igualmente
+     */
+    static void cortarHistograma(int* histograma, int limite);
+
+    // Sub-histogramas intercalados: pixels vizinhos contam em pistas diferentes,
+    // e valores repetidos não esperam o incremento anterior da mesma posição
+    static const int PISTAS = 4;
+
+    static void contarPistas(const cv::Mat& imagem, int linhaInicio, int linhaFim,
+                             int colunaInicio, int colunaFim, std::vector<unsigned int>& pistas);
 };
 
 #endif
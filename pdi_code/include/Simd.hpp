@@ -0,0 +1,115 @@
+#ifndef SIMD_HPP
+#define SIMD_HPP
+
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+// Arquitetura alvo dos núcleos vetorizados
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define PDI_SIMD_X86 1
+#elif defined(__ARM_NEON) || defined(__aarch64__) || defined(_M_ARM64)
+#define PDI_SIMD_NEON 1
+#endif
+
+/**
+ * Conjuntos de instruções vetoriais suportados pelos núcleos SIMD
+ */
+enum class NivelSimd {
+    ESCALAR,    // Sem vetorização (referência)
+    SSE41,      // x86 SSE4.1, 128 bits
+    AVX2,       // x86 AVX2, 256 bits
+    NEON        // ARM NEON, 128 bits
+};
+
+/**
+ * CLASSE: Simd
+ *
+ * Detecção em tempo de execução do conjunto de instruções da CPU e despacho
+ * para núcleos vetorizados. Um mesmo executável roda o melhor caminho
+ * disponível na máquina: cada variante (SSE4.1, AVX2, NEON) é compilada com
+ * seu próprio alvo e escolhida apenas se a CPU a suportar.
+ *
+ * Os núcleos são escritos uma única vez (SimdNucleos.inl) sobre wrappers
+ * portáveis de intrínsecos, e produzem resultados idênticos bit a bit aos
+ * laços escalares de referência.
+ */
+class Simd {
+public:
+    /**
+     * Melhor nível suportado pela CPU (detectado uma única vez)
+     */
+    static NivelSimd nivelDisponivel();
+
+    /**
+     * Nível efetivamente usado: o disponível, limitado por limitarNivel()
+     */
+    static NivelSimd nivelAtivo();
+
+    /**
+     * Limita o nível usado pelos núcleos (ex.: ESCALAR para comparar com a referência)
+     * @param nivel Nível máximo permitido
+     */
+    static void limitarNivel(NivelSimd nivel);
+
+    /**
+     * Nome legível do nível (para relatórios)
+     */
+    static const char* nome(NivelSimd nivel);
+
+    /**
+     * Empacota os coeficientes int16 de um kernel k x k em pares (c[i], c[i+1])
+     * de 32 bits por linha do kernel; linhas ímpares completam o par com 0.
+     * Formato esperado por convolucaoInteiraLinha.
+     */
+    static std::vector<int> empacotarParesCoeficientes(const std::vector<short>& coeficientes,
+                                                       int tamanhoKernel);
+
+    /**
+     * Convolução em ponto fixo de uma linha de saída
+     * saida[x] = sat8((soma de linhas[ky][x + kx] * c[ky][kx]) >> deslocamento)
+     * @param linhas k ponteiros de linha, já deslocados para o primeiro pixel do kernel
+     * @param pares Coeficientes empacotados por empacotarParesCoeficientes
+     * @return Número de pixels calculados (o restante fica para o laço escalar)
+     */
+    static int convolucaoInteiraLinha(const uchar* const* linhas, const int* pares, int tamanhoKernel,
+                                      int deslocamento, uchar* saida, int largura);
+
+    /**
+     * Cinza ponderado (BT.601) de uma linha BGR, em inteiros:
+     * cinza[x] = (114*B + 587*G + 299*R) / 1000
+     * @return Número de pixels calculados (o restante fica para o laço escalar)
+     */
+    static int cinzaPonderadoLinha(const uchar* bgr, uchar* cinza, int largura);
+
+    /**
+     * Cinza por média aritmética de uma linha BGR: cinza[x] = (B + G + R) / 3
+     * @return Número de pixels calculados (o restante fica para o laço escalar)
+     */
+    static int cinzaMediaLinha(const uchar* bgr, uchar* cinza, int largura);
+
+    /**
+     * Mínimo/máximo elemento a elemento de duas linhas: destino[x] = min(a[x], b[x])
+     * (destino pode ser a própria a ou b)
+     * @return Número de pixels calculados (o restante fica para o laço escalar)
+     */
+    static int minimoLinha(const uchar* a, const uchar* b, uchar* destino, int largura);
+    static int maximoLinha(const uchar* a, const uchar* b, uchar* destino, int largura);
+
+private:
+    static int convolucaoInteiraLinhaSSE41(const uchar* const* linhas, const int* pares, int tamanhoKernel,
+                                           int deslocamento, uchar* saida, int largura);
+    static int convolucaoInteiraLinhaAVX2(const uchar* const* linhas, const int* pares, int tamanhoKernel,
+                                          int deslocamento, uchar* saida, int largura);
+    static int convolucaoInteiraLinhaNEON(const uchar* const* linhas, const int* pares, int tamanhoKernel,
+                                          int deslocamento, uchar* saida, int largura);
+
+    static int cinzaLinhaSSE41(const uchar* bgr, uchar* cinza, int largura, bool ponderada);
+    static int cinzaLinhaAVX2(const uchar* bgr, uchar* cinza, int largura, bool ponderada);
+    static int cinzaLinhaNEON(const uchar* bgr, uchar* cinza, int largura, bool ponderada);
+
+    static int minMaxLinhaSSE41(const uchar* a, const uchar* b, uchar* destino, int largura, bool minimo);
+    static int minMaxLinhaAVX2(const uchar* a, const uchar* b, uchar* destino, int largura, bool minimo);
+    static int minMaxLinhaNEON(const uchar* a, const uchar* b, uchar* destino, int largura, bool minimo);
+};
+
+#endif
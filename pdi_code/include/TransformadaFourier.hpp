@@ -0,0 +1,70 @@
+#ifndef TRANSFORMADA_FOURIER_HPP
+#define TRANSFORMADA_FOURIER_HPP
+
+#include <complex>
+#include <vector>
+
+/**
+ * CLASSE: TransformadaFourier
+ *
+ * Transformada rápida de Fourier (FFT) de tamanho fixo, implementada manualmente
+ * (Cooley-Tukey de raiz mista, sem bibliotecas externas).
+ *
+ * Conceitos:
+ * - O tamanho n é fatorado em 4, 2, 3, 5 e, se necessário, outros primos
+ * - Raízes 2, 3, 4 e 5 têm borboletas dedicadas; os demais fatores usam DFT direta
+ * - Os fatores de rotação (twiddles) são calculados uma vez no construtor
+ *
+ * Um objeto pode ser reutilizado para várias transformadas do mesmo tamanho,
+ * mas não deve ser compartilhado entre threads (usa buffer interno).
+ */
+class TransformadaFourier {
+public:
+    typedef std::complex<double> Complexo;
+
+    /**
+     * Prepara o plano da FFT para sequências de tamanho n
+     * @param n Tamanho da transformada (n >= 1)
+     */
+    explicit TransformadaFourier(int n);
+
+    /**
+     * Executa a transformada no próprio vetor de dados
+     * @param dados Vetor com n valores (espaçados de "passo" elementos)
+     * @param inversa true para a transformada inversa (já normalizada por 1/n)
+     * @param passo Distância entre elementos consecutivos (ex.: colunas de uma matriz)
+     */
+    void executar(Complexo* dados, bool inversa, int passo = 1);
+
+    int tamanho() const { return n; }
+
+    /**
+     * Menor tamanho >= n cuja fatoração só tem 2, 3 e 5 (FFT eficiente)
+     */
+    static int tamanhoOtimo(int n);
+
+    /**
+     * FFT 2-D in-place de uma matriz linhas x colunas armazenada linha a linha,
+     * com planos já preparados (reaproveitados entre várias matrizes)
+     * @param planoLinhas Plano de tamanho colunas (transforma cada linha)
+     * @param planoColunas Plano de tamanho linhas (transforma cada coluna)
+     */
+    static void fft2D(std::vector<Complexo>& dados, TransformadaFourier& planoLinhas,
+                      TransformadaFourier& planoColunas, bool inversa);
+
+private:
+    int n;
+    std::vector<int> fatores;
+    std::vector<Complexo> twiddles;
+    std::vector<Complexo> entrada;
+    std::vector<Complexo> saida;
+
+    /**
+     * Etapa recursiva de decimação no tempo: resolve as subsequências de
+     * tamanho m = tamanho / fator e combina com borboletas de raiz "fator"
+     */
+    void fftRecursiva(const Complexo* origem, Complexo* destino, int tamanho,
+                      int passoOrigem, size_t nivel, bool inversa);
+};
+
+#endif
@@ -0,0 +1,101 @@
+#include "BufferLinhasBorda.hpp"
+#include <cstring>
+
+BufferLinhasBorda::BufferLinhasBorda(const cv::Mat& imagem, int raioVertical, int raioHorizontal,
+                                     ModoBorda borda, uchar valorConstante)
+    : imagem(imagem),
+      raioVertical(raioVertical),
+      raioHorizontal(raioHorizontal),
+      borda(borda),
+      valorConstante(valorConstante),
+      larguraComBorda(imagem.cols + 2 * raioHorizontal),
+      linhaAtual(-1),
+      anel(static_cast<size_t>(2 * raioVertical + 1) * (imagem.cols + 2 * raioHorizontal) + FOLGA_VETORIAL, 0),
+      linhas(2 * raioVertical + 1, nullptr),
+      colunasEsquerda(raioHorizontal),
+      colunasDireita(raioHorizontal) {
+    // Pré-calcula de onde vem cada coluna da extensão horizontal
+    for (int i = 0; i < raioHorizontal; i++) {
+        colunasEsquerda[i] = mapearIndice(i - raioHorizontal, imagem.cols, borda);
+        colunasDireita[i] = mapearIndice(imagem.cols + i, imagem.cols, borda);
+    }
+}
+
+void BufferLinhasBorda::posicionar(int y) {
+    if (linhaAtual >= 0 && y == linhaAtual + 1) {
+        // Avanço de uma linha: só a nova linha inferior precisa ser copiada
+        preencherLinha(y + raioVertical);
+    } else {
+        for (int yy = y - raioVertical; yy <= y + raioVertical; yy++) {
+            preencherLinha(yy);
+        }
+    }
+    linhaAtual = y;
+
+    for (int i = 0; i <= 2 * raioVertical; i++) {
+        linhas[i] = posicaoNoAnel(y - raioVertical + i) + raioHorizontal;
+    }
+}
+
+int BufferLinhasBorda::mapearIndice(int indice, int tamanho, ModoBorda borda) {
+    if (indice >= 0 && indice < tamanho) {
+        return indice;
+    }
+
+    switch (borda) {
+        case ModoBorda::REPLICAR:
+            return indice < 0 ? 0 : tamanho - 1;
+
+        case ModoBorda::CIRCULAR:
+            indice %= tamanho;
+            return indice < 0 ? indice + tamanho : indice;
+
+        case ModoBorda::REFLETIR:
+        case ModoBorda::REFLETIR_101: {
+            if (tamanho == 1) {
+                return 0;
+            }
+            // Reflete repetidamente até cair dentro da imagem (raios maiores que a imagem)
+            int ajuste = (borda == ModoBorda::REFLETIR_101) ? 1 : 0;
+            while (indice < 0 || indice >= tamanho) {
+                if (indice < 0) {
+                    indice = -indice - 1 + ajuste;
+                } else {
+                    indice = 2 * tamanho - indice - 1 - ajuste;
+                }
+            }
+            return indice;
+        }
+
+        case ModoBorda::CONSTANTE:
+        default:
+            return -1;
+    }
+}
+
+void BufferLinhasBorda::preencherLinha(int yy) {
+    uchar* destino = posicaoNoAnel(yy);
+    int origem = mapearIndice(yy, imagem.rows, borda);
+
+    // Linha inteira fora da imagem no modo constante
+    if (origem < 0) {
+        std::memset(destino, valorConstante, larguraComBorda);
+        return;
+    }
+
+    const uchar* linhaOrigem = imagem.ptr<uchar>(origem);
+    std::memcpy(destino + raioHorizontal, linhaOrigem, imagem.cols);
+
+    for (int i = 0; i < raioHorizontal; i++) {
+        int colEsq = colunasEsquerda[i];
+        int colDir = colunasDireita[i];
+        destino[i] = (colEsq < 0) ? valorConstante : linhaOrigem[colEsq];
+        destino[raioHorizontal + imagem.cols + i] = (colDir < 0) ? valorConstante : linhaOrigem[colDir];
+    }
+}
+
+uchar* BufferLinhasBorda::posicaoNoAnel(int yy) {
+    int tamanhoJanela = 2 * raioVertical + 1;
+    int slot = ((yy % tamanhoJanela) + tamanhoJanela) % tamanhoJanela;
+    return anel.data() + static_cast<size_t>(slot) * larguraComBorda;
+}
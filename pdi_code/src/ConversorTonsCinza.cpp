@@ -1,32 +1,119 @@
 #include "ConversorTonsCinza.hpp"
+#include "ExecutorParalelo.hpp"
+#include "Simd.hpp"
+#include <iostream>
+#include <vector>
 
 cv::Mat ConversorTonsCinza::paraMediaAritmetica(const cv::Mat& imagemColorida) {
-    cv::Mat resultado = imagemColorida.clone();
+    if (imagemColorida.channels() != 3) {
+        return imagemColorida.clone();
+    }
     
-    for (int y = 0; y < imagemColorida.rows; y++) {
-        for (int x = 0; x < imagemColorida.cols; x++) {
-            if (imagemColorida.channels() == 3) {
-                cv::Vec3b pixel = imagemColorida.at<cv::Vec3b>(y, x);
-                uchar media = (pixel[0] + pixel[1] + pixel[2]) / 3;
-                resultado.at<cv::Vec3b>(y, x) = cv::Vec3b(media, media, media);
-            }
+    cv::Mat resultado(imagemColorida.size(), imagemColorida.type());
+    ExecutorParalelo::executarFaixas(imagemColorida.rows, [&](int inicio, int fim) {
+        std::vector<uchar> cinza(imagemColorida.cols);
+        for (int y = inicio; y < fim; y++) {
+            linhaMediaAritmetica(imagemColorida.ptr<uchar>(y), cinza.data(), imagemColorida.cols);
+            replicarCanais(cinza.data(), resultado.ptr<uchar>(y), imagemColorida.cols);
         }
-    }
+    });
     return resultado;
 }
 
 cv::Mat ConversorTonsCinza::paraMediaPonderada(const cv::Mat& imagemColorida) {
-    cv::Mat resultado = imagemColorida.clone();
+    if (imagemColorida.channels() != 3) {
+        return imagemColorida.clone();
+    }
     
-    for (int y = 0; y < imagemColorida.rows; y++) {
-        for (int x = 0; x < imagemColorida.cols; x++) {
-            if (imagemColorida.channels() == 3) {
-                cv::Vec3b pixel = imagemColorida.at<cv::Vec3b>(y, x);
-                // Fórmula padrão ITU-R BT.709: 0.299*R + 0.587*G + 0.114*B
-                uchar mediaPonderada = static_cast<uchar>(0.114 * pixel[0] + 0.587 * pixel[1] + 0.299 * pixel[2]);
-                resultado.at<cv::Vec3b>(y, x) = cv::Vec3b(mediaPonderada, mediaPonderada, mediaPonderada);
-            }
+    cv::Mat resultado(imagemColorida.size(), imagemColorida.type());
+    ExecutorParalelo::executarFaixas(imagemColorida.rows, [&](int inicio, int fim) {
+        std::vector<uchar> cinza(imagemColorida.cols);
+        for (int y = inicio; y < fim; y++) {
+            // Fórmula padrão ITU-R BT.601: 0.299*R + 0.587*G + 0.114*B
+            linhaMediaPonderada(imagemColorida.ptr<uchar>(y), cinza.data(), imagemColorida.cols);
+            replicarCanais(cinza.data(), resultado.ptr<uchar>(y), imagemColorida.cols);
         }
-    }
+    });
+    return resultado;
+}
+
+cv::Mat ConversorTonsCinza::paraMediaAritmeticaUmCanal(const cv::Mat& imagem) {
+    cv::Mat resultado;
+    paraMediaAritmeticaUmCanal(imagem, resultado);
+    return resultado;
+}
+
+cv::Mat ConversorTonsCinza::paraMediaPonderadaUmCanal(const cv::Mat& imagem) {
+    cv::Mat resultado;
+    paraMediaPonderadaUmCanal(imagem, resultado);
     return resultado;
 }
+
+void ConversorTonsCinza::paraMediaAritmeticaUmCanal(const cv::Mat& imagem, cv::Mat& destino) {
+    if (!prepararDestino(imagem, destino)) {
+        return;
+    }
+    
+    ExecutorParalelo::executarFaixas(imagem.rows, [&](int inicio, int fim) {
+        for (int y = inicio; y < fim; y++) {
+            linhaMediaAritmetica(imagem.ptr<uchar>(y), destino.ptr<uchar>(y), imagem.cols);
+        }
+    });
+}
+
+void ConversorTonsCinza::paraMediaPonderadaUmCanal(const cv::Mat& imagem, cv::Mat& destino) {
+    if (!prepararDestino(imagem, destino)) {
+        return;
+    }
+    
+    ExecutorParalelo::executarFaixas(imagem.rows, [&](int inicio, int fim) {
+        for (int y = inicio; y < fim; y++) {
+            linhaMediaPonderada(imagem.ptr<uchar>(y), destino.ptr<uchar>(y), imagem.cols);
+        }
+    });
+}
+
+bool ConversorTonsCinza::prepararDestino(const cv::Mat& imagem, cv::Mat& destino) {
+    if (imagem.channels() != 1 && imagem.channels() != 3) {
+        std::cerr << "Erro: Conversão para cinza espera imagem de 1 ou 3 canais!" << std::endl;
+        destino.release();
+        return false;
+    }
+    
+    // Entrada já em cinza: apenas copia (nada a fazer se for o próprio destino)
+    if (imagem.channels() == 1) {
+        if (destino.data != imagem.data) {
+            imagem.copyTo(destino);
+        }
+        return false;
+    }
+    
+    // Não faz nada se o destino já tiver o tamanho e o tipo certos
+    destino.create(imagem.rows, imagem.cols, CV_8UC1);
+    return true;
+}
+
+void ConversorTonsCinza::linhaMediaPonderada(const uchar* bgr, uchar* cinza, int largura) {
+    // Pesos em milésimos somam 1000: cinzas puros (B = G = R) são preservados exatamente
+    int x = Simd::cinzaPonderadoLinha(bgr, cinza, largura);
+    for (; x < largura; x++) {
+        const uchar* pixel = bgr + 3 * x;
+        cinza[x] = static_cast<uchar>((114 * pixel[0] + 587 * pixel[1] + 299 * pixel[2]) / 1000);
+    }
+}
+
+void ConversorTonsCinza::linhaMediaAritmetica(const uchar* bgr, uchar* cinza, int largura) {
+    int x = Simd::cinzaMediaLinha(bgr, cinza, largura);
+    for (; x < largura; x++) {
+        const uchar* pixel = bgr + 3 * x;
+        cinza[x] = static_cast<uchar>((pixel[0] + pixel[1] + pixel[2]) / 3);
+    }
+}
+
+void ConversorTonsCinza::replicarCanais(const uchar* cinza, uchar* bgr, int largura) {
+    for (int x = 0; x < largura; x++) {
+        bgr[3 * x] = cinza[x];
+        bgr[3 * x + 1] = cinza[x];
+        bgr[3 * x + 2] = cinza[x];
+    }
+}
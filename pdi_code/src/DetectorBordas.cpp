@@ -1,4 +1,7 @@
 #include "DetectorBordas.hpp"
+#include "ConversorTonsCinza.hpp"
+#include "ExecutorParalelo.hpp"
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 
@@ -22,188 +25,268 @@ cv::Mat DetectorBordas::roberts(const cv::Mat& imagem) {
     // Cria imagem de saída
     cv::Mat resultado = cv::Mat::zeros(imagemCinza.size(), CV_8UC1);
     
-    // Aplica operador de Roberts
-    for (int y = 0; y < imagemCinza.rows - 1; y++) {
-        for (int x = 0; x < imagemCinza.cols - 1; x++) {
-            // Calcula gradientes
-            double gx = aplicarKernel2x2(imagemCinza, y, x, kernelGx);
-            double gy = aplicarKernel2x2(imagemCinza, y, x, kernelGy);
-            
-            // Calcula magnitude
-            double magnitude = calcularMagnitude(gx, gy);
-            
-            // Armazena resultado
-            resultado.at<uchar>(y, x) = normalizar(magnitude);
+    // Aplica operador de Roberts (faixas de linhas em paralelo)
+    ExecutorParalelo::executarFaixas(imagemCinza.rows - 1, [&](int inicio, int fim) {
+        for (int y = inicio; y < fim; y++) {
+            for (int x = 0; x < imagemCinza.cols - 1; x++) {
+                // Calcula gradientes
+                double gx = aplicarKernel2x2(imagemCinza, y, x, kernelGx);
+                double gy = aplicarKernel2x2(imagemCinza, y, x, kernelGy);
+                
+                // Calcula magnitude
+                double magnitude = calcularMagnitude(gx, gy);
+                
+                // Armazena resultado
+                resultado.at<uchar>(y, x) = normalizar(magnitude);
+            }
         }
-    }
+    });
     
     return resultado;
 }
 
-cv::Mat DetectorBordas::sobel(const cv::Mat& imagem) {
+cv::Mat DetectorBordas::sobel(const cv::Mat& imagem, ModoMagnitude modo) {
     // Converte para cinza se necessário
     cv::Mat imagemCinza = converterParaCinza(imagem);
     
-    // Kernels de Sobel (3x3)
-    // Gx detecta bordas verticais
-    const int kernelGx[3][3] = {
-        {-1, 0, 1},
-        {-2, 0, 2},
-        {-1, 0, 1}
-    };
+    // Cria imagem de saída (a moldura de 1 pixel permanece zerada)
+    cv::Mat resultado = cv::Mat::zeros(imagemCinza.size(), CV_8UC1);
     
-    // Gy detecta bordas horizontais
-    const int kernelGy[3][3] = {
-        {-1, -2, -1},
-        { 0,  0,  0},
-        { 1,  2,  1}
-    };
+    ExecutorParalelo::executarFaixas(imagemCinza.rows, [&](int inicio, int fim) {
+        sobelFaixa(imagemCinza, modo, 0, resultado, nullptr, inicio, fim);
+    });
+    
+    return resultado;
+}
+
+cv::Mat DetectorBordas::sobel(const cv::Mat& imagem, int limiar, cv::Mat& mapaLimiar, ModoMagnitude modo) {
+    cv::Mat imagemCinza = converterParaCinza(imagem);
     
-    // Cria imagem de saída
     cv::Mat resultado = cv::Mat::zeros(imagemCinza.size(), CV_8UC1);
     
-    // Aplica operador de Sobel
-    for (int y = 1; y < imagemCinza.rows - 1; y++) {
-        for (int x = 1; x < imagemCinza.cols - 1; x++) {
-            // Calcula gradientes
-            double gx = aplicarKernel3x3(imagemCinza, y, x, kernelGx);
-            double gy = aplicarKernel3x3(imagemCinza, y, x, kernelGy);
+    // A moldura tem magnitude 0; no mapa recebe o mesmo valor que aplicarLimiar daria
+    mapaLimiar = cv::Mat(imagemCinza.size(), CV_8UC1, cv::Scalar(0 > limiar ? 255 : 0));
+    
+    ExecutorParalelo::executarFaixas(imagemCinza.rows, [&](int inicio, int fim) {
+        sobelFaixa(imagemCinza, modo, limiar, resultado, &mapaLimiar, inicio, fim);
+    });
+    
+    return resultado;
+}
+
+void DetectorBordas::sobelFaixa(const cv::Mat& imagemCinza, ModoMagnitude modo, int limiar,
+                                cv::Mat& resultado, cv::Mat* mapaLimiar, int linhaInicio, int linhaFim) {
+    int linhas = imagemCinza.rows;
+    int colunas = imagemCinza.cols;
+    if (linhas < 3 || colunas < 3) {
+        return;
+    }
+    
+    const std::vector<uchar>& raiz = tabelaRaizInteira();
+    
+    // Somas parciais verticais de cada coluna:
+    // Gx = suavizacao[x+1] - suavizacao[x-1], Gy = diferenca[x-1] + 2*diferenca[x] + diferenca[x+1]
+    std::vector<short> suavizacao(colunas);
+    std::vector<short> diferenca(colunas);
+    
+    int inicio = std::max(linhaInicio, 1);
+    int fim = std::min(linhaFim, linhas - 1);
+    
+    for (int y = inicio; y < fim; y++) {
+        const uchar* acima = imagemCinza.ptr<uchar>(y - 1);
+        const uchar* centro = imagemCinza.ptr<uchar>(y);
+        const uchar* abaixo = imagemCinza.ptr<uchar>(y + 1);
+        uchar* saida = resultado.ptr<uchar>(y);
+        
+        somasParciaisVerticais(acima, centro, abaixo, suavizacao.data(), diferenca.data(), colunas);
+        
+        switch (modo) {
+            case ModoMagnitude::L1:
+                for (int x = 1; x < colunas - 1; x++) {
+                    int gx = suavizacao[x + 1] - suavizacao[x - 1];
+                    int gy = diferenca[x - 1] + 2 * diferenca[x] + diferenca[x + 1];
+                    int magnitude = std::abs(gx) + std::abs(gy);
+                    saida[x] = static_cast<uchar>(magnitude > 255 ? 255 : magnitude);
+                }
+                break;
             
-            // Calcula magnitude
-            double magnitude = calcularMagnitude(gx, gy);
+            case ModoMagnitude::RAIZ_INTEIRA:
+                for (int x = 1; x < colunas - 1; x++) {
+                    int gx = suavizacao[x + 1] - suavizacao[x - 1];
+                    int gy = diferenca[x - 1] + 2 * diferenca[x] + diferenca[x + 1];
+                    int quadrado = gx * gx + gy * gy;
+                    saida[x] = quadrado < 65536 ? raiz[quadrado] : 255;
+                }
+                break;
             
-            // Armazena resultado
-            resultado.at<uchar>(y, x) = normalizar(magnitude);
+            case ModoMagnitude::L2:
+            default:
+                for (int x = 1; x < colunas - 1; x++) {
+                    int gx = suavizacao[x + 1] - suavizacao[x - 1];
+                    int gy = diferenca[x - 1] + 2 * diferenca[x] + diferenca[x + 1];
+                    // Quadrados até 2·1020² são exatos em float; a truncagem coincide com a de double
+                    float magnitude = std::sqrt(static_cast<float>(gx * gx + gy * gy));
+                    saida[x] = magnitude > 255.0f ? 255 : static_cast<uchar>(magnitude);
+                }
+                break;
+        }
+        
+        // Limiarização na mesma passada, enquanto a linha ainda está em cache
+        if (mapaLimiar != nullptr) {
+            uchar* binaria = mapaLimiar->ptr<uchar>(y);
+            for (int x = 1; x < colunas - 1; x++) {
+                binaria[x] = (saida[x] > limiar) ? 255 : 0;
+            }
         }
     }
-    
-    return resultado;
+}
+
+const std::vector<uchar>& DetectorBordas::tabelaRaizInteira() {
+    static const std::vector<uchar> tabela = [] {
+        std::vector<uchar> raiz(65536);
+        int r = 0;
+        for (int i = 0; i < 65536; i++) {
+            while ((r + 1) * (r + 1) <= i) {
+                r++;
+            }
+            raiz[i] = static_cast<uchar>(r);
+        }
+        return raiz;
+    }();
+    return tabela;
 }
 
 cv::Mat DetectorBordas::robinson(const cv::Mat& imagem) {
     // Converte para cinza se necessário
     cv::Mat imagemCinza = converterParaCinza(imagem);
     
-    // Kernels de Robinson (8 direções)
-    // Norte
-    const int kernelN[3][3] = {
-        {-1, 0, 1},
-        {-2, 0, 2},
-        {-1, 0, 1}
-    };
-    
-    // Nordeste
-    const int kernelNE[3][3] = {
-        { 0, 1, 2},
-        {-1, 0, 1},
-        {-2,-1, 0}
-    };
+    // Cria imagem de saída (a moldura de 1 pixel permanece zerada)
+    cv::Mat resultado = cv::Mat::zeros(imagemCinza.size(), CV_8UC1);
     
-    // Leste
-    const int kernelE[3][3] = {
-        { 1, 2, 1},
-        { 0, 0, 0},
-        {-1,-2,-1}
-    };
+    ExecutorParalelo::executarFaixas(imagemCinza.rows, [&](int inicio, int fim) {
+        robinsonFaixa(imagemCinza, resultado, nullptr, inicio, fim);
+    });
     
-    // Sudeste
-    const int kernelSE[3][3] = {
-        { 2, 1, 0},
-        { 1, 0,-1},
-        { 0,-1,-2}
-    };
+    return resultado;
+}
+
+cv::Mat DetectorBordas::robinson(const cv::Mat& imagem, cv::Mat& mapaOrientacao) {
+    cv::Mat imagemCinza = converterParaCinza(imagem);
     
-    // Sul
-    const int kernelS[3][3] = {
-        { 1, 0,-1},
-        { 2, 0,-2},
-        { 1, 0,-1}
-    };
+    cv::Mat resultado = cv::Mat::zeros(imagemCinza.size(), CV_8UC1);
+    mapaOrientacao = cv::Mat::zeros(imagemCinza.size(), CV_8UC1);
     
-    // Sudoeste
-    const int kernelSW[3][3] = {
-        { 0,-1,-2},
-        { 1, 0,-1},
-        { 2, 1, 0}
-    };
+    ExecutorParalelo::executarFaixas(imagemCinza.rows, [&](int inicio, int fim) {
+        robinsonFaixa(imagemCinza, resultado, &mapaOrientacao, inicio, fim);
+    });
     
-    // Oeste
-    const int kernelW[3][3] = {
-        {-1,-2,-1},
-        { 0, 0, 0},
-        { 1, 2, 1}
-    };
+    return resultado;
+}
+
+void DetectorBordas::robinsonFaixa(const cv::Mat& imagemCinza, cv::Mat& resultado, cv::Mat* mapaOrientacao,
+                                   int linhaInicio, int linhaFim) {
+    int linhas = imagemCinza.rows;
+    int colunas = imagemCinza.cols;
+    if (linhas < 3 || colunas < 3) {
+        return;
+    }
     
-    // Noroeste
-    const int kernelNW[3][3] = {
-        {-2,-1, 0},
-        {-1, 0, 1},
-        { 0, 1, 2}
-    };
+    // Kernels de Robinson (8 direções), com p(i,j) = vizinho na linha i e coluna j da janela:
+    //   N  = [-1 0 1; -2 0 2; -1 0 1]   = Gx do Sobel
+    //   E  = [ 1 2 1;  0 0 0; -1 -2 -1] = -Gy do Sobel
+    //   NE = [ 0 1 2; -1 0 1; -2 -1 0]  = (Gx - Gy)/2 + (p02 - p20)
+    //   SE = [ 2 1 0;  1 0 -1; 0 -1 -2] = -(Gx + Gy)/2 + (p00 - p22)
+    //   S, SW, W e NW são as negações de N, NE, E e SE
+    // Basta calcular 4 respostas; o sinal indica qual direção do par venceu.
+    std::vector<short> suavizacao(colunas);
+    std::vector<short> diferenca(colunas);
     
-    // Cria imagem de saída
-    cv::Mat resultado = cv::Mat::zeros(imagemCinza.size(), CV_8UC1);
+    int inicio = std::max(linhaInicio, 1);
+    int fim = std::min(linhaFim, linhas - 1);
     
-    // Aplica operador de Robinson
-    for (int y = 1; y < imagemCinza.rows - 1; y++) {
-        for (int x = 1; x < imagemCinza.cols - 1; x++) {
-            // Calcula resposta em todas as 8 direções
-            double respostas[8];
-            respostas[0] = std::abs(aplicarKernel3x3(imagemCinza, y, x, kernelN));
-            respostas[1] = std::abs(aplicarKernel3x3(imagemCinza, y, x, kernelNE));
-            respostas[2] = std::abs(aplicarKernel3x3(imagemCinza, y, x, kernelE));
-            respostas[3] = std::abs(aplicarKernel3x3(imagemCinza, y, x, kernelSE));
-            respostas[4] = std::abs(aplicarKernel3x3(imagemCinza, y, x, kernelS));
-            respostas[5] = std::abs(aplicarKernel3x3(imagemCinza, y, x, kernelSW));
-            respostas[6] = std::abs(aplicarKernel3x3(imagemCinza, y, x, kernelW));
-            respostas[7] = std::abs(aplicarKernel3x3(imagemCinza, y, x, kernelNW));
+    for (int y = inicio; y < fim; y++) {
+        const uchar* acima = imagemCinza.ptr<uchar>(y - 1);
+        const uchar* centro = imagemCinza.ptr<uchar>(y);
+        const uchar* abaixo = imagemCinza.ptr<uchar>(y + 1);
+        uchar* saida = resultado.ptr<uchar>(y);
+        
+        somasParciaisVerticais(acima, centro, abaixo, suavizacao.data(), diferenca.data(), colunas);
+        
+        if (mapaOrientacao == nullptr) {
+            for (int x = 1; x < colunas - 1; x++) {
+                int gx = suavizacao[x + 1] - suavizacao[x - 1];
+                int gy = diferenca[x - 1] + 2 * diferenca[x] + diferenca[x + 1];
+                int ne = (gx - gy) / 2 + (acima[x + 1] - abaixo[x - 1]);
+                int se = -(gx + gy) / 2 + (acima[x - 1] - abaixo[x + 1]);
+                
+                int maxResposta = std::max(std::max(std::abs(gx), std::abs(gy)),
+                                           std::max(std::abs(ne), std::abs(se)));
+                saida[x] = static_cast<uchar>(maxResposta > 255 ? 255 : maxResposta);
+            }
+            continue;
+        }
+        
+        uchar* orientacao = mapaOrientacao->ptr<uchar>(y);
+        for (int x = 1; x < colunas - 1; x++) {
+            int gx = suavizacao[x + 1] - suavizacao[x - 1];
+            int gy = diferenca[x - 1] + 2 * diferenca[x] + diferenca[x + 1];
+            
+            // Respostas de N, NE, E e SE (na ordem dos índices 0 a 3)
+            int respostas[4] = {
+                gx,
+                (gx - gy) / 2 + (acima[x + 1] - abaixo[x - 1]),
+                -gy,
+                -(gx + gy) / 2 + (acima[x - 1] - abaixo[x + 1])
+            };
             
-            // Pega o máximo de todas as direções
-            double maxResposta = respostas[0];
-            for (int i = 1; i < 8; i++) {
-                if (respostas[i] > maxResposta) {
-                    maxResposta = respostas[i];
+            // Resposta negativa significa que venceu a direção oposta (índice + 4)
+            int maxResposta = -1;
+            int direcao = 0;
+            for (int i = 0; i < 4; i++) {
+                int valor = std::abs(respostas[i]);
+                int indice = (respostas[i] < 0) ? i + 4 : i;
+                if (valor > maxResposta || (valor == maxResposta && indice < direcao)) {
+                    maxResposta = valor;
+                    direcao = indice;
                 }
             }
             
-            // Armazena resultado
-            resultado.at<uchar>(y, x) = normalizar(maxResposta);
+            saida[x] = static_cast<uchar>(maxResposta > 255 ? 255 : maxResposta);
+            orientacao[x] = static_cast<uchar>(direcao);
         }
     }
-    
-    return resultado;
+}
+
+void DetectorBordas::somasParciaisVerticais(const uchar* acima, const uchar* centro, const uchar* abaixo,
+                                            short* suavizacao, short* diferenca, int colunas) {
+    for (int x = 0; x < colunas; x++) {
+        suavizacao[x] = static_cast<short>(acima[x] + 2 * centro[x] + abaixo[x]);
+        diferenca[x] = static_cast<short>(abaixo[x] - acima[x]);
+    }
 }
 
 cv::Mat DetectorBordas::aplicarLimiar(const cv::Mat& imagemBordas, int limiar) {
     cv::Mat resultado = imagemBordas.clone();
     
-    for (int y = 0; y < imagemBordas.rows; y++) {
-        for (int x = 0; x < imagemBordas.cols; x++) {
-            uchar valor = imagemBordas.at<uchar>(y, x);
-            resultado.at<uchar>(y, x) = (valor > limiar) ? 255 : 0;
+    ExecutorParalelo::executarFaixas(imagemBordas.rows, [&](int inicio, int fim) {
+        for (int y = inicio; y < fim; y++) {
+            for (int x = 0; x < imagemBordas.cols; x++) {
+                uchar valor = imagemBordas.at<uchar>(y, x);
+                resultado.at<uchar>(y, x) = (valor > limiar) ? 255 : 0;
+            }
         }
-    }
+    });
     
     return resultado;
 }
 
 cv::Mat DetectorBordas::converterParaCinza(const cv::Mat& imagem) {
     if (imagem.channels() == 1) {
-        return imagem.clone();
-    }
-    
-    cv::Mat imagemCinza = cv::Mat(imagem.rows, imagem.cols, CV_8UC1);
-    
-    for (int y = 0; y < imagem.rows; y++) {
-        for (int x = 0; x < imagem.cols; x++) {
-            cv::Vec3b pixel = imagem.at<cv::Vec3b>(y, x);
-            // Média ponderada para conversão RGB -> Cinza
-            uchar cinza = static_cast<uchar>(0.299 * pixel[2] + 0.587 * pixel[1] + 0.114 * pixel[0]);
-            imagemCinza.at<uchar>(y, x) = cinza;
-        }
+        // Os operadores só leem a imagem: não é preciso copiar
+        return imagem;
     }
     
-    return imagemCinza;
+    return ConversorTonsCinza::paraMediaPonderadaUmCanal(imagem);
 }
 
 double DetectorBordas::calcularMagnitude(double gx, double gy) {
@@ -238,16 +321,3 @@ double DetectorBordas::aplicarKernel2x2(const cv::Mat& imagem, int y, int x, con
     
     return soma;
 }
-
-double DetectorBordas::aplicarKernel3x3(const cv::Mat& imagem, int y, int x, const int kernel[3][3]) {
-    double soma = 0.0;
-    
-    for (int ky = -1; ky <= 1; ky++) {
-        for (int kx = -1; kx <= 1; kx++) {
-            uchar pixel = imagem.at<uchar>(y + ky, x + kx);
-            soma += pixel * kernel[ky + 1][kx + 1];
-        }
-    }
-    
-    return soma;
-}
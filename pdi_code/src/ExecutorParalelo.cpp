@@ -0,0 +1,202 @@
+#include "ExecutorParalelo.hpp"
+#include <algorithm>
+#include <cstdlib>
+
+// Faixas criadas por thread: mais de uma equilibra a carga quando as faixas
+// têm custos diferentes (o roubo de tarefas redistribui o excedente)
+static const int FAIXAS_POR_THREAD = 4;
+
+// Protege a criação e a troca da instância global
+static std::mutex travaInstancia;
+
+// Verdadeiro enquanto a thread atual executa uma tarefa do executor
+static thread_local bool dentroDeTarefa = false;
+
+static int numeroThreadsPadrao() {
+    const char* variavel = std::getenv("PDI_NUM_THREADS");
+    if (variavel != nullptr) {
+        int valor = std::atoi(variavel);
+        if (valor > 0) {
+            return valor;
+        }
+    }
+    int nucleos = static_cast<int>(std::thread::hardware_concurrency());
+    return std::max(nucleos, 1);
+}
+
+ExecutorParalelo::ExecutorParalelo(int numeroThreads)
+    : quantidadeThreads(numeroThreads),
+      tarefasNaoIniciadas(0),
+      encerrar(false) {
+    for (int i = 0; i < quantidadeThreads; i++) {
+        filas.push_back(std::unique_ptr<Fila>(new Fila()));
+    }
+    // A fila 0 é atendida pelas threads que chamam executarFaixas
+    for (int i = 1; i < quantidadeThreads; i++) {
+        threads.emplace_back(&ExecutorParalelo::cicloTrabalhador, this, i);
+    }
+}
+
+ExecutorParalelo::~ExecutorParalelo() {
+    {
+        std::lock_guard<std::mutex> trava(travaEspera);
+        encerrar = true;
+    }
+    haTarefas.notify_all();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+std::unique_ptr<ExecutorParalelo>& ExecutorParalelo::ponteiroInstancia() {
+    static std::unique_ptr<ExecutorParalelo> executor;
+    return executor;
+}
+
+ExecutorParalelo& ExecutorParalelo::instancia() {
+    std::lock_guard<std::mutex> trava(travaInstancia);
+    std::unique_ptr<ExecutorParalelo>& executor = ponteiroInstancia();
+    if (!executor) {
+        executor.reset(new ExecutorParalelo(numeroThreadsPadrao()));
+    }
+    return *executor;
+}
+
+void ExecutorParalelo::definirNumeroThreads(int numeroThreads) {
+    if (numeroThreads <= 0) {
+        numeroThreads = std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+    }
+
+    std::lock_guard<std::mutex> trava(travaInstancia);
+    std::unique_ptr<ExecutorParalelo>& executor = ponteiroInstancia();
+    if (executor && executor->quantidadeThreads == numeroThreads) {
+        return;
+    }
+    executor.reset();
+    executor.reset(new ExecutorParalelo(numeroThreads));
+}
+
+int ExecutorParalelo::numeroThreads() {
+    return instancia().quantidadeThreads;
+}
+
+void ExecutorParalelo::executarFaixas(int totalLinhas, const TarefaFaixa& tarefa, int linhasMinimas) {
+    if (totalLinhas <= 0) {
+        return;
+    }
+    instancia().executar(totalLinhas, tarefa, linhasMinimas);
+}
+
+void ExecutorParalelo::executar(int totalLinhas, const TarefaFaixa& tarefa, int linhasMinimas) {
+    int maximoFaixas = totalLinhas / std::max(linhasMinimas, 1);
+
+    // Sem ganho possível, ou chamada aninhada: executa na própria thread
+    if (quantidadeThreads == 1 || dentroDeTarefa || maximoFaixas <= 1) {
+        tarefa(0, totalLinhas);
+        return;
+    }
+
+    int numeroFaixas = std::min(maximoFaixas, FAIXAS_POR_THREAD * quantidadeThreads);
+
+    Grupo grupo;
+    grupo.tarefa = &tarefa;
+    grupo.pendentes = numeroFaixas;
+
+    // Faixas consecutivas vão para a mesma fila (linhas vizinhas no mesmo núcleo)
+    tarefasNaoIniciadas += numeroFaixas;
+    for (int i = 0; i < numeroFaixas; i++) {
+        Tarefa faixa;
+        faixa.grupo = &grupo;
+        faixa.inicio = static_cast<int>(static_cast<long long>(totalLinhas) * i / numeroFaixas);
+        faixa.fim = static_cast<int>(static_cast<long long>(totalLinhas) * (i + 1) / numeroFaixas);
+
+        Fila& fila = *filas[static_cast<long long>(i) * quantidadeThreads / numeroFaixas];
+        std::lock_guard<std::mutex> trava(fila.trava);
+        fila.tarefas.push_back(faixa);
+    }
+    {
+        std::lock_guard<std::mutex> trava(travaEspera);
+    }
+    haTarefas.notify_all();
+
+    // A thread que chamou também trabalha até não haver mais tarefas disponíveis
+    Tarefa atual;
+    while (grupo.pendentes > 0 && obterTarefa(0, atual)) {
+        executarTarefa(atual);
+    }
+
+    {
+        std::unique_lock<std::mutex> trava(grupo.trava);
+        grupo.concluido.wait(trava, [&grupo] { return grupo.pendentes == 0; });
+    }
+
+    if (grupo.erro) {
+        std::rethrow_exception(grupo.erro);
+    }
+}
+
+void ExecutorParalelo::cicloTrabalhador(int indice) {
+    Tarefa atual;
+    while (true) {
+        if (obterTarefa(indice, atual)) {
+            executarTarefa(atual);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> trava(travaEspera);
+        haTarefas.wait(trava, [this] { return encerrar || tarefasNaoIniciadas > 0; });
+        if (encerrar && tarefasNaoIniciadas <= 0) {
+            return;
+        }
+    }
+}
+
+bool ExecutorParalelo::obterTarefa(int indice, Tarefa& tarefa) {
+    // Própria fila: retira do fim (faixa mais recente, ainda quente no cache)
+    {
+        Fila& fila = *filas[indice];
+        std::lock_guard<std::mutex> trava(fila.trava);
+        if (!fila.tarefas.empty()) {
+            tarefa = fila.tarefas.back();
+            fila.tarefas.pop_back();
+            tarefasNaoIniciadas--;
+            return true;
+        }
+    }
+
+    // Roubo: retira do início das outras filas
+    for (int passo = 1; passo < quantidadeThreads; passo++) {
+        Fila& fila = *filas[(indice + passo) % quantidadeThreads];
+        std::lock_guard<std::mutex> trava(fila.trava);
+        if (!fila.tarefas.empty()) {
+            tarefa = fila.tarefas.front();
+            fila.tarefas.pop_front();
+            tarefasNaoIniciadas--;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ExecutorParalelo::executarTarefa(const Tarefa& tarefa) {
+    Grupo* grupo = tarefa.grupo;
+
+    bool anterior = dentroDeTarefa;
+    dentroDeTarefa = true;
+    try {
+        (*grupo->tarefa)(tarefa.inicio, tarefa.fim);
+    } catch (...) {
+        std::lock_guard<std::mutex> trava(grupo->trava);
+        if (!grupo->erro) {
+            grupo->erro = std::current_exception();
+        }
+    }
+    dentroDeTarefa = anterior;
+
+    // O decremento fica sob a trava: quem espera só destrói o grupo depois de soltá-la
+    std::lock_guard<std::mutex> trava(grupo->trava);
+    if (--grupo->pendentes == 0) {
+        grupo->concluido.notify_all();
+    }
+}
@@ -0,0 +1,406 @@
+#include "FiltrosOrdenacao.hpp"
+#include "ConversorTonsCinza.hpp"
+#include "ExecutorParalelo.hpp"
+#include "Simd.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+
+// Pixels de saída por bloco da rede: amortiza a chamada de cada comparador, e as
+// linhas de todas as posições ainda cabem no cache L2
+static const int LARGURA_BLOCO_REDE = 1024;
+
+// Histogramas de dois níveis: 16 faixas grossas de 16 níveis finos
+static const int FAIXAS = 16;
+
+// Colunas (com borda) por faixa vertical do filtro por histogramas: 512 bytes cada
+static const int COLUNAS_HISTOGRAMAS = 512;
+
+static int potenciaDeDois(int n) {
+    int p = 1;
+    while (p < n) {
+        p <<= 1;
+    }
+    return p;
+}
+
+static void minimoLinhas(const uchar* a, const uchar* b, uchar* destino, int n) {
+    for (int x = Simd::minimoLinha(a, b, destino, n); x < n; x++) {
+        destino[x] = std::min(a[x], b[x]);
+    }
+}
+
+static void maximoLinhas(const uchar* a, const uchar* b, uchar* destino, int n) {
+    for (int x = Simd::maximoLinha(a, b, destino, n); x < n; x++) {
+        destino[x] = std::max(a[x], b[x]);
+    }
+}
+
+static cv::Mat paraCinza(const cv::Mat& imagem) {
+    if (imagem.channels() == 1) {
+        return imagem;
+    }
+    return ConversorTonsCinza::paraMediaPonderadaUmCanal(imagem);
+}
+
+cv::Mat FiltrosOrdenacao::filtroMediana(const cv::Mat& imagem, int tamanho,
+                                        ModoBorda borda, uchar valorConstante) {
+    return filtroPosto(imagem, tamanho, tamanho * tamanho / 2, borda, valorConstante);
+}
+
+cv::Mat FiltrosOrdenacao::filtroPercentil(const cv::Mat& imagem, int tamanho, double percentil,
+                                          ModoBorda borda, uchar valorConstante) {
+    if (!(percentil >= 0.0 && percentil <= 100.0)) {
+        std::cerr << "Erro: Percentil deve estar entre 0 e 100!" << std::endl;
+        return imagem.clone();
+    }
+    int ultimo = tamanho * tamanho - 1;
+    int posto = static_cast<int>(std::lround(percentil / 100.0 * ultimo));
+    return filtroPosto(imagem, tamanho, posto, borda, valorConstante);
+}
+
+cv::Mat FiltrosOrdenacao::filtroPosto(const cv::Mat& imagem, int tamanho, int posto,
+                                      ModoBorda borda, uchar valorConstante) {
+    if (tamanho < 1) {
+        std::cerr << "Erro: Tamanho da janela deve ser >= 1!" << std::endl;
+        return imagem.clone();
+    }
+    if (posto < 0 || posto >= tamanho * tamanho) {
+        std::cerr << "Erro: Posto deve estar entre 0 e tamanho² - 1!" << std::endl;
+        return imagem.clone();
+    }
+
+    cv::Mat imagemCinza = paraCinza(imagem);
+    if (imagemCinza.type() != CV_8UC1) {
+        std::cerr << "Erro: Filtros de ordenação exigem imagem de 8 bits!" << std::endl;
+        return imagem.clone();
+    }
+    cv::Mat resultado(imagemCinza.size(), CV_8UC1);
+
+    // Sem SIMD cada comparador custa um laço escalar por linha: só a rede 3x3
+    // ainda vence os histogramas
+    int raio = tamanho / 2;
+    bool usarRede = raio <= RAIO_MAXIMO_REDE &&
+                    (raio <= 1 || Simd::nivelAtivo() != NivelSimd::ESCALAR);
+    if (usarRede) {
+        redeSelecao(tamanho, posto);   // monta fora das faixas paralelas
+    }
+
+    ExecutorParalelo::executarFaixas(imagemCinza.rows, [&](int inicio, int fim) {
+        if (usarRede) {
+            filtrarRede(imagemCinza, tamanho, posto, borda, valorConstante, resultado, inicio, fim);
+        } else {
+            filtrarHistogramas(imagemCinza, tamanho, posto, borda, valorConstante, resultado, inicio, fim);
+        }
+    }, 4 * tamanho);
+
+    return resultado;
+}
+
+std::vector<FiltrosOrdenacao::Comparador> FiltrosOrdenacao::redeBatcher(int blocos, int tamanhoBloco,
+                                                                        bool apenasIntercalacao,
+                                                                        std::vector<int>& posicaoFinal) {
+    int blocoPotencia = potenciaDeDois(tamanhoBloco);
+    int total = blocoPotencia * potenciaDeDois(blocos);
+
+    // Posição de Batcher -> posição real (-1 = vazia, +infinito)
+    std::vector<int> ocupante(total, -1);
+    for (int b = 0; b < blocos; b++) {
+        for (int i = 0; i < tamanhoBloco; i++) {
+            ocupante[b * blocoPotencia + i] = b * tamanhoBloco + i;
+        }
+    }
+
+    std::vector<Comparador> rede;
+    for (int p = apenasIntercalacao ? blocoPotencia : 1; p < total; p <<= 1) {
+        for (int k = p; k >= 1; k >>= 1) {
+            for (int j = k % p; j + k < total; j += 2 * k) {
+                for (int i = 0; i < std::min(k, total - j - k); i++) {
+                    int a = i + j;
+                    int b = i + j + k;
+                    if ((a / (2 * p)) != (b / (2 * p))) {
+                        continue;
+                    }
+                    if (ocupante[b] < 0) {
+                        continue;                       // máximo com +infinito: nada muda
+                    }
+                    if (ocupante[a] < 0) {
+                        std::swap(ocupante[a], ocupante[b]);   // o valor real desce sem custo
+                        continue;
+                    }
+                    rede.push_back({ocupante[a], ocupante[b], true, true});
+                }
+            }
+        }
+    }
+
+    posicaoFinal.assign(blocos * tamanhoBloco, -1);
+    for (int i = 0; i < blocos * tamanhoBloco; i++) {
+        posicaoFinal[i] = ocupante[i];
+    }
+    return rede;
+}
+
+void FiltrosOrdenacao::podarRede(std::vector<Comparador>& rede, std::vector<bool>& usadas) {
+    std::vector<Comparador> podada;
+    for (int c = static_cast<int>(rede.size()) - 1; c >= 0; c--) {
+        Comparador comparador = rede[c];
+        comparador.usaMinimo = usadas[comparador.minimo];
+        comparador.usaMaximo = usadas[comparador.maximo];
+        if (!comparador.usaMinimo && !comparador.usaMaximo) {
+            continue;
+        }
+        // Qualquer saída usada depende das duas entradas
+        usadas[comparador.minimo] = true;
+        usadas[comparador.maximo] = true;
+        podada.push_back(comparador);
+    }
+    std::reverse(podada.begin(), podada.end());
+    rede.swap(podada);
+}
+
+const FiltrosOrdenacao::RedeSelecao& FiltrosOrdenacao::redeSelecao(int tamanho, int posto) {
+    // Cache de redes, indexado por (tamanho, posto); as redes nunca são removidas
+    static std::mutex travaRedes;
+    static std::map<std::pair<int, int>, std::unique_ptr<const RedeSelecao>> cacheRedes;
+
+    std::pair<int, int> chave(tamanho, posto);
+    std::lock_guard<std::mutex> trava(travaRedes);
+    auto encontrado = cacheRedes.find(chave);
+    if (encontrado != cacheRedes.end()) {
+        return *encontrado->second;
+    }
+
+    std::unique_ptr<RedeSelecao> rede(new RedeSelecao());
+
+    // Janela: posição c * tamanho + i = i-ésimo menor valor da coluna c
+    std::vector<int> posicaoFinal;
+    rede->janela = redeBatcher(tamanho, tamanho, true, posicaoFinal);
+    rede->saida = posicaoFinal[posto];
+    std::vector<bool> usadas(tamanho * tamanho, false);
+    usadas[rede->saida] = true;
+    podarRede(rede->janela, usadas);
+
+    // Postos das colunas que alguma coluna da janela ainda lê
+    rede->postoColunaUsado.assign(tamanho, false);
+    for (int posicao = 0; posicao < tamanho * tamanho; posicao++) {
+        if (usadas[posicao]) {
+            rede->postoColunaUsado[posicao % tamanho] = true;
+        }
+    }
+
+    // Colunas: ordena os tamanho valores e devolve cada posto na posição de mesmo índice
+    std::vector<int> postoColuna;
+    rede->colunas = redeBatcher(1, tamanho, false, postoColuna);
+    std::vector<bool> usadasColuna(tamanho, false);
+    for (int i = 0; i < tamanho; i++) {
+        if (rede->postoColunaUsado[i]) {
+            usadasColuna[postoColuna[i]] = true;
+        }
+    }
+    podarRede(rede->colunas, usadasColuna);
+    rede->postoColuna = postoColuna;
+
+    const RedeSelecao& referencia = *rede;
+    cacheRedes.emplace(chave, std::move(rede));
+    return referencia;
+}
+
+void FiltrosOrdenacao::executarRede(const std::vector<Comparador>& rede, std::vector<const uchar*>& entradas,
+                                    std::vector<uchar*>& memoria, int n) {
+    uchar*& reserva = memoria.back();
+    for (const Comparador& comparador : rede) {
+        const uchar* a = entradas[comparador.minimo];
+        const uchar* b = entradas[comparador.maximo];
+        // O mínimo vai para a reserva antes que o máximo sobrescreva b
+        if (comparador.usaMinimo) {
+            minimoLinhas(a, b, reserva, n);
+        }
+        if (comparador.usaMaximo) {
+            // A linha própria de maximo nunca é a entrada a (pode ser b: elemento a elemento)
+            maximoLinhas(a, b, memoria[comparador.maximo], n);
+            entradas[comparador.maximo] = memoria[comparador.maximo];
+        }
+        if (comparador.usaMinimo) {
+            // A reserva troca de dono com a linha de minimo
+            std::swap(memoria[comparador.minimo], reserva);
+            entradas[comparador.minimo] = memoria[comparador.minimo];
+        }
+    }
+}
+
+void FiltrosOrdenacao::filtrarRede(const cv::Mat& imagemCinza, int tamanho, int posto,
+                                   ModoBorda borda, uchar valorConstante,
+                                   cv::Mat& resultado, int linhaInicio, int linhaFim) {
+    const RedeSelecao& rede = redeSelecao(tamanho, posto);
+    int raio = tamanho / 2;
+    int largura = imagemCinza.cols;
+    int larguraColuna = LARGURA_BLOCO_REDE + 2 * raio;
+
+    BufferLinhasBorda janela(imagemCinza, raio, raio, borda, valorConstante);
+
+    // Uma linha por posição de cada rede, mais a reserva
+    std::vector<uchar> dadosColuna(static_cast<size_t>(tamanho + 1) * larguraColuna);
+    std::vector<uchar> dadosJanela(static_cast<size_t>(tamanho * tamanho + 1) * LARGURA_BLOCO_REDE);
+    std::vector<uchar*> memoriaColuna(tamanho + 1);
+    std::vector<uchar*> memoriaJanela(tamanho * tamanho + 1);
+    std::vector<const uchar*> entradasColuna(tamanho);
+    std::vector<const uchar*> entradasJanela(tamanho * tamanho);
+
+    for (int y = linhaInicio; y < linhaFim; y++) {
+        janela.posicionar(y);
+        uchar* linhaSaida = resultado.ptr<uchar>(y);
+
+        for (int x0 = 0; x0 < largura; x0 += LARGURA_BLOCO_REDE) {
+            int n = std::min(LARGURA_BLOCO_REDE, largura - x0);
+
+            // Ordena cada coluna (com as colunas extras da janela: raio antes,
+            // tamanho - 1 - raio depois)
+            for (int i = 0; i <= tamanho; i++) {
+                memoriaColuna[i] = dadosColuna.data() + static_cast<size_t>(i) * larguraColuna;
+            }
+            for (int i = 0; i < tamanho; i++) {
+                entradasColuna[i] = janela.linha(i - raio) + x0 - raio;
+            }
+            executarRede(rede.colunas, entradasColuna, memoriaColuna, n + tamanho - 1);
+
+            // A coluna c da janela do pixel x é a coluna ordenada deslocada de c
+            for (int i = 0; i <= tamanho * tamanho; i++) {
+                memoriaJanela[i] = dadosJanela.data() + static_cast<size_t>(i) * LARGURA_BLOCO_REDE;
+            }
+            for (int c = 0; c < tamanho; c++) {
+                for (int i = 0; i < tamanho; i++) {
+                    entradasJanela[c * tamanho + i] = rede.postoColunaUsado[i]
+                        ? entradasColuna[rede.postoColuna[i]] + c
+                        : nullptr;
+                }
+            }
+            executarRede(rede.janela, entradasJanela, memoriaJanela, n);
+
+            std::memcpy(linhaSaida + x0, entradasJanela[rede.saida], n);
+        }
+    }
+}
+
+void FiltrosOrdenacao::filtrarHistogramas(const cv::Mat& imagemCinza, int tamanho, int posto,
+                                          ModoBorda borda, uchar valorConstante,
+                                          cv::Mat& resultado, int linhaInicio, int linhaFim) {
+    // Janela de "antes" pixels antes do central a "depois" pixels depois (iguais se ímpar)
+    int antes = tamanho / 2;
+    int depois = tamanho - 1 - antes;
+    int largura = imagemCinza.cols;
+
+    // Faixas verticais: os histogramas das colunas de uma faixa cabem no cache L2
+    int larguraFaixa = std::max(COLUNAS_HISTOGRAMAS - (tamanho - 1), tamanho);
+
+    std::vector<unsigned short> finosColunas(static_cast<size_t>(larguraFaixa + tamanho - 1) * 256);
+    std::vector<unsigned short> grossosColunas(static_cast<size_t>(larguraFaixa + tamanho - 1) * FAIXAS);
+
+    BufferLinhasBorda linhaEntrada(imagemCinza, 0, antes, borda, valorConstante);
+    BufferLinhasBorda linhaSaidaJanela(imagemCinza, 0, antes, borda, valorConstante);
+
+    // Histograma da janela: as faixas grossas deslizam a cada pixel; cada faixa
+    // fina lembra a posição x em que foi atualizada pela última vez
+    int grossos[FAIXAS];
+    int finos[256];
+    int atualizadoEm[FAIXAS];
+
+    for (int x0 = 0; x0 < largura; x0 += larguraFaixa) {
+        int n = std::min(larguraFaixa, largura - x0);
+        int colunas = n + tamanho - 1;    // coluna j da faixa = coluna x0 - antes + j da imagem
+
+        std::fill(finosColunas.begin(), finosColunas.end(), 0);
+        std::fill(grossosColunas.begin(), grossosColunas.end(), 0);
+        for (int yy = linhaInicio - antes; yy <= linhaInicio + depois; yy++) {
+            linhaEntrada.posicionar(yy);
+            const uchar* pixels = linhaEntrada.linha(0) + x0 - antes;
+            for (int j = 0; j < colunas; j++) {
+                finosColunas[static_cast<size_t>(j) * 256 + pixels[j]]++;
+                grossosColunas[static_cast<size_t>(j) * FAIXAS + (pixels[j] >> 4)]++;
+            }
+        }
+
+        for (int y = linhaInicio; y < linhaFim; y++) {
+            if (y > linhaInicio) {
+                // Desliza a janela vertical de cada coluna: entra y + depois, sai y - antes - 1
+                linhaEntrada.posicionar(y + depois);
+                linhaSaidaJanela.posicionar(y - antes - 1);
+                const uchar* entra = linhaEntrada.linha(0) + x0 - antes;
+                const uchar* sai = linhaSaidaJanela.linha(0) + x0 - antes;
+                for (int j = 0; j < colunas; j++) {
+                    if (entra[j] == sai[j]) {
+                        continue;
+                    }
+                    unsigned short* fino = &finosColunas[static_cast<size_t>(j) * 256];
+                    unsigned short* grosso = &grossosColunas[static_cast<size_t>(j) * FAIXAS];
+                    fino[entra[j]]++;
+                    fino[sai[j]]--;
+                    grosso[entra[j] >> 4]++;
+                    grosso[sai[j] >> 4]--;
+                }
+            }
+
+            std::fill(grossos, grossos + FAIXAS, 0);
+            for (int j = 0; j < tamanho; j++) {
+                const unsigned short* grosso = &grossosColunas[static_cast<size_t>(j) * FAIXAS];
+                for (int f = 0; f < FAIXAS; f++) {
+                    grossos[f] += grosso[f];
+                }
+            }
+            std::fill(atualizadoEm, atualizadoEm + FAIXAS, -2 * tamanho);
+
+            uchar* linhaSaida = resultado.ptr<uchar>(y) + x0;
+            for (int x = 0; x < n; x++) {
+                if (x > 0) {
+                    const unsigned short* entraGrosso = &grossosColunas[static_cast<size_t>(x + tamanho - 1) * FAIXAS];
+                    const unsigned short* saiGrosso = &grossosColunas[static_cast<size_t>(x - 1) * FAIXAS];
+                    for (int f = 0; f < FAIXAS; f++) {
+                        grossos[f] += entraGrosso[f] - saiGrosso[f];
+                    }
+                }
+
+                // Faixa grossa onde está o posto
+                int acumulado = 0;
+                int faixa = 0;
+                while (acumulado + grossos[faixa] <= posto) {
+                    acumulado += grossos[faixa];
+                    faixa++;
+                }
+
+                // Traz a faixa fina até a janela atual: desliza se estiver perto,
+                // senão soma as colunas da janela do zero
+                int* fino = finos + faixa * FAIXAS;
+                int passos = x - atualizadoEm[faixa];
+                if (2 * passos >= tamanho) {
+                    std::fill(fino, fino + FAIXAS, 0);
+                    for (int j = x; j < x + tamanho; j++) {
+                        const unsigned short* coluna = &finosColunas[static_cast<size_t>(j) * 256 + faixa * FAIXAS];
+                        for (int f = 0; f < FAIXAS; f++) {
+                            fino[f] += coluna[f];
+                        }
+                    }
+                } else {
+                    for (int p = atualizadoEm[faixa] + 1; p <= x; p++) {
+                        const unsigned short* entraFino = &finosColunas[static_cast<size_t>(p + tamanho - 1) * 256 + faixa * FAIXAS];
+                        const unsigned short* saiFino = &finosColunas[static_cast<size_t>(p - 1) * 256 + faixa * FAIXAS];
+                        for (int f = 0; f < FAIXAS; f++) {
+                            fino[f] += entraFino[f] - saiFino[f];
+                        }
+                    }
+                }
+                atualizadoEm[faixa] = x;
+
+                int nivel = 0;
+                while (acumulado + fino[nivel] <= posto) {
+                    acumulado += fino[nivel];
+                    nivel++;
+                }
+                linhaSaida[x] = static_cast<uchar>(faixa * FAIXAS + nivel);
+            }
+        }
+    }
+}
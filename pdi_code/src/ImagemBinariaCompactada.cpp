@@ -0,0 +1,90 @@
+#include "ImagemBinariaCompactada.hpp"
+#include "ConversorTonsCinza.hpp"
+#include "ExecutorParalelo.hpp"
+#include <algorithm>
+
+ImagemBinariaCompactada::ImagemBinariaCompactada()
+    : numeroLinhas(0),
+      numeroColunas(0),
+      palavras(0) {
+}
+
+ImagemBinariaCompactada::ImagemBinariaCompactada(int linhas, int colunas)
+    : numeroLinhas(std::max(linhas, 0)),
+      numeroColunas(std::max(colunas, 0)),
+      palavras((std::max(colunas, 0) + 63) / 64),
+      dados(static_cast<size_t>(std::max(linhas, 0)) * ((std::max(colunas, 0) + 63) / 64), 0) {
+}
+
+ImagemBinariaCompactada::ImagemBinariaCompactada(const cv::Mat& imagem, int limiar)
+    : ImagemBinariaCompactada(imagem.rows, imagem.cols) {
+    cv::Mat cinza;
+    if (imagem.channels() == 1) {
+        cinza = imagem;
+    } else {
+        ConversorTonsCinza::paraMediaPonderadaUmCanal(imagem, cinza);
+    }
+    if (cinza.type() != CV_8UC1) {
+        return;
+    }
+
+    ExecutorParalelo::executarFaixas(numeroLinhas, [&](int inicio, int fim) {
+        for (int y = inicio; y < fim; y++) {
+            const uchar* origem = cinza.ptr<uchar>(y);
+            uint64_t* destino = linha(y);
+            for (int p = 0; p < palavras; p++) {
+                int x0 = p * 64;
+                int n = std::min(64, numeroColunas - x0);
+                uint64_t palavra = 0;
+                for (int i = 0; i < n; i++) {
+                    palavra |= static_cast<uint64_t>(origem[x0 + i] > limiar) << i;
+                }
+                destino[p] = palavra;
+            }
+        }
+    });
+}
+
+cv::Mat ImagemBinariaCompactada::paraMat() const {
+    cv::Mat resultado(numeroLinhas, numeroColunas, CV_8UC1);
+
+    ExecutorParalelo::executarFaixas(numeroLinhas, [&](int inicio, int fim) {
+        for (int y = inicio; y < fim; y++) {
+            const uint64_t* origem = linha(y);
+            uchar* destino = resultado.ptr<uchar>(y);
+            for (int p = 0; p < palavras; p++) {
+                int x0 = p * 64;
+                int n = std::min(64, numeroColunas - x0);
+                uint64_t palavra = origem[p];
+                for (int i = 0; i < n; i++) {
+                    // 0 - 1 = 0xFF...: bit ligado vira 255
+                    destino[x0 + i] = static_cast<uchar>(0 - ((palavra >> i) & 1));
+                }
+            }
+        }
+    });
+
+    return resultado;
+}
+
+uint64_t ImagemBinariaCompactada::mascaraUltimaPalavra() const {
+    int resto = numeroColunas & 63;
+    return resto == 0 ? ~uint64_t(0) : (uint64_t(1) << resto) - 1;
+}
+
+void ImagemBinariaCompactada::mascaraColunas(int colunaInicio, int colunaFim, uint64_t* destino) const {
+    colunaInicio = std::max(colunaInicio, 0);
+    colunaFim = std::min(colunaFim, numeroColunas);
+    for (int p = 0; p < palavras; p++) {
+        int x0 = p * 64;
+        int a = std::max(colunaInicio - x0, 0);
+        int b = std::min(colunaFim - x0, 64);
+        if (a >= b) {
+            destino[p] = 0;
+        } else {
+            uint64_t ateB = (b == 64) ? ~uint64_t(0) : (uint64_t(1) << b) - 1;
+            uint64_t ateA = (uint64_t(1) << a) - 1;
+            destino[p] = ateB & ~ateA;
+        }
+    }
+}
@@ -0,0 +1,96 @@
+#include "ImagemBinariaRLE.hpp"
+#include "ConversorTonsCinza.hpp"
+#include "ExecutorParalelo.hpp"
+#include <algorithm>
+#include <cstring>
+
+ImagemBinariaRLE::ImagemBinariaRLE()
+    : numeroLinhas(0),
+      numeroColunas(0),
+      inicioLinha(1, 0) {
+}
+
+ImagemBinariaRLE::ImagemBinariaRLE(int linhas, int colunas)
+    : numeroLinhas(std::max(linhas, 0)),
+      numeroColunas(std::max(colunas, 0)),
+      inicioLinha(std::max(linhas, 0) + 1, 0) {
+}
+
+ImagemBinariaRLE::ImagemBinariaRLE(const cv::Mat& imagem, int limiar)
+    : ImagemBinariaRLE(imagem.rows, imagem.cols) {
+    cv::Mat cinza;
+    if (imagem.channels() == 1) {
+        cinza = imagem;
+    } else {
+        ConversorTonsCinza::paraMediaPonderadaUmCanal(imagem, cinza);
+    }
+    if (cinza.type() != CV_8UC1) {
+        return;
+    }
+
+    // Cada faixa codifica as suas linhas; depois tudo é juntado em ordem
+    std::vector<std::vector<Segmento>> porLinha(numeroLinhas);
+    ExecutorParalelo::executarFaixas(numeroLinhas, [&](int inicio, int fim) {
+        for (int y = inicio; y < fim; y++) {
+            const uchar* linha = cinza.ptr<uchar>(y);
+            std::vector<Segmento>& segmentosLinha = porLinha[y];
+            int x = 0;
+            while (x < numeroColunas) {
+                while (x < numeroColunas && linha[x] <= limiar) {
+                    x++;
+                }
+                if (x == numeroColunas) {
+                    break;
+                }
+                Segmento segmento;
+                segmento.inicio = x;
+                while (x < numeroColunas && linha[x] > limiar) {
+                    x++;
+                }
+                segmento.fim = x;
+                segmentosLinha.push_back(segmento);
+            }
+        }
+    });
+
+    *this = deLinhas(numeroLinhas, numeroColunas, porLinha);
+}
+
+ImagemBinariaRLE ImagemBinariaRLE::deLinhas(int linhas, int colunas,
+                                            const std::vector<std::vector<Segmento>>& porLinha) {
+    ImagemBinariaRLE resultado(linhas, colunas);
+    for (int y = 0; y < resultado.numeroLinhas; y++) {
+        resultado.inicioLinha[y + 1] = resultado.inicioLinha[y] + porLinha[y].size();
+    }
+    resultado.dados.resize(resultado.inicioLinha[resultado.numeroLinhas]);
+    for (int y = 0; y < resultado.numeroLinhas; y++) {
+        std::copy(porLinha[y].begin(), porLinha[y].end(), resultado.dados.begin() + resultado.inicioLinha[y]);
+    }
+    return resultado;
+}
+
+cv::Mat ImagemBinariaRLE::paraMat() const {
+    cv::Mat resultado(numeroLinhas, numeroColunas, CV_8UC1);
+
+    ExecutorParalelo::executarFaixas(numeroLinhas, [&](int inicio, int fim) {
+        for (int y = inicio; y < fim; y++) {
+            uchar* linha = resultado.ptr<uchar>(y);
+            std::memset(linha, 0, numeroColunas);
+            const Segmento* segmentosLinha = segmentos(y);
+            for (int i = 0; i < numeroSegmentos(y); i++) {
+                std::memset(linha + segmentosLinha[i].inicio, 255,
+                            segmentosLinha[i].fim - segmentosLinha[i].inicio);
+            }
+        }
+    });
+
+    return resultado;
+}
+
+long long ImagemBinariaRLE::area() const {
+    long long total = 0;
+    for (const Segmento& segmento : dados) {
+        total += segmento.fim - segmento.inicio;
+    }
+    return total;
+}
@@ -1,114 +1,849 @@
 #include "MorfologiaMatematica.hpp"
+#include "ConversorTonsCinza.hpp"
+#include "ExecutorParalelo.hpp"
+#include "PlanejadorElementoEstruturante.hpp"
+#include "Simd.hpp"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <limits>
+#include <vector>
 
-cv::Mat MorfologiaMatematica::erosao(const cv::Mat& imagem, const cv::Mat& elementoEstruturante) {
-    // Converte para binária se necessário
-    cv::Mat imagemBinaria = converterParaBinaria(imagem);
+// Operações combinadas pelo filtro de van Herk/Gil-Werman e pela morfologia
+// compactada. Em palavras de bits, mínimo é E e máximo é OU, bit a bit.
+struct OperacaoMinimo {
+    static inline uchar aplicar(uchar a, uchar b) { return a < b ? a : b; }
+    static inline uint64_t aplicar(uint64_t a, uint64_t b) { return a & b; }
+    static constexpr uint64_t NEUTRO = ~uint64_t(0);
+    static constexpr bool EH_MINIMO = true;
+};
+
+struct OperacaoMaximo {
+    static inline uchar aplicar(uchar a, uchar b) { return a > b ? a : b; }
+    static inline uint64_t aplicar(uint64_t a, uint64_t b) { return a | b; }
+    static constexpr uint64_t NEUTRO = 0;
+    static constexpr bool EH_MINIMO = false;
+};
+
+/**
+ * destino[x] = op(a[x], b[x]) numa linha de bytes, pelo núcleo SIMD quando
+ * disponível (destino pode ser a própria a ou b)
+ */
+template <typename Op>
+static inline void combinarLinhas(const uchar* a, const uchar* b, uchar* destino, int largura) {
+    int x = Op::EH_MINIMO ? Simd::minimoLinha(a, b, destino, largura)
+                          : Simd::maximoLinha(a, b, destino, largura);
+    for (; x < largura; x++) {
+        destino[x] = Op::aplicar(a[x], b[x]);
+    }
+}
+
+/**
+ * Mesma operação em palavras de 64 pixels compactados
+ */
+template <typename Op>
+static inline void combinarLinhas(const uint64_t* a, const uint64_t* b, uint64_t* destino, int largura) {
+    for (int x = 0; x < largura; x++) {
+        destino[x] = Op::aplicar(a[x], b[x]);
+    }
+}
+
+/**
+ * van Herk/Gil-Werman em uma linha: saida[x] = op(entrada[x + a .. x + b])
+ * para x em [saidaInicio, saidaFim). A linha é dividida em blocos de
+ * k = b - a + 1 pixels; prefixo[x] acumula do início do bloco até x e
+ * sufixo[x] de x até o fim do bloco. Toda janela cobre no máximo dois blocos
+ * vizinhos, então saida[x] = op(sufixo[x + a], prefixo[x + b]).
+ * A janela precisa caber na linha para todo x pedido.
+ */
+template <typename Op>
+static void vanHerkLinha(const uchar* entrada, uchar* saida, int n, int a, int b,
+                         int saidaInicio, int saidaFim, uchar* prefixo, uchar* sufixo) {
+    int k = b - a + 1;
+    for (int inicio = 0; inicio < n; inicio += k) {
+        int fim = std::min(inicio + k, n);
+        prefixo[inicio] = entrada[inicio];
+        for (int x = inicio + 1; x < fim; x++) {
+            prefixo[x] = Op::aplicar(prefixo[x - 1], entrada[x]);
+        }
+        sufixo[fim - 1] = entrada[fim - 1];
+        for (int x = fim - 2; x >= inicio; x--) {
+            sufixo[x] = Op::aplicar(sufixo[x + 1], entrada[x]);
+        }
+    }
+    for (int x = saidaInicio; x < saidaFim; x++) {
+        saida[x] = Op::aplicar(sufixo[x + a], prefixo[x + b]);
+    }
+}
+
+// Maior janela horizontal feita por duplicação (no máximo 6 passadas SIMD);
+// acima disso van Herk mantém o custo constante no comprimento
+static const int JANELA_MAXIMA_DUPLICACAO = 32;
+
+/**
+ * Janela horizontal por duplicação, com o mesmo contrato de vanHerkLinha:
+ * após o passo de comprimento L, tabela[x] = op(entrada[x .. x + 2L - 1]),
+ * e a janela de k pixels sai de duas tabelas de potência de 2 sobrepostas.
+ * São log2(k) + 1 passadas elemento a elemento sobre linhas deslocadas, todas
+ * pelo núcleo SIMD: em janelas curtas, mais barato que as ~3 comparações
+ * escalares por pixel de van Herk quando há vetores de 16-32 bytes.
+ */
+template <typename Op>
+static void duplicacaoLinha(const uchar* entrada, uchar* saida, int n, int a, int b,
+                            int saidaInicio, int saidaFim, uchar* tabela, uchar* auxiliar) {
+    int k = b - a + 1;
+    const uchar* atual = entrada;
+    int comprimento = 1;
+    while (2 * comprimento <= k) {
+        combinarLinhas<Op>(atual, atual + comprimento, tabela, n - 2 * comprimento + 1);
+        atual = tabela;
+        std::swap(tabela, auxiliar);
+        comprimento *= 2;
+    }
+    combinarLinhas<Op>(atual + saidaInicio + a, atual + saidaInicio + b - comprimento + 1,
+                       saida + saidaInicio, saidaFim - saidaInicio);
+}
+
+/**
+ * Mesma ideia na vertical (janela de linhas [y + a, y + b]), para uma faixa
+ * de "largura" elementos por linha: os prefixos e sufixos são linhas inteiras
+ * da faixa, e o laço interno percorre elementos contíguos (núcleo SIMD de
+ * mínimo/máximo para bytes). Serve para pixels (uchar) e para palavras de 64 pixels compactados.
+ * @param linhaEntrada Função y -> ponteiro para o início da faixa na linha y
+ * @param linhaSaida Função y -> ponteiro de saída (y em [saidaInicio, saidaFim))
+ */
+template <typename Op, typename T, typename Entrada, typename Saida>
+static void vanHerkVertical(int linhas, int largura, int a, int b, int saidaInicio, int saidaFim,
+                            Entrada linhaEntrada, Saida linhaSaida) {
+    int k = b - a + 1;
+    std::vector<T> prefixo(static_cast<size_t>(linhas) * largura);
+    std::vector<T> sufixo(static_cast<size_t>(linhas) * largura);
     
-    // Cria imagem de saída
-    cv::Mat resultado = cv::Mat::zeros(imagemBinaria.size(), CV_8UC1);
+    auto linhaPrefixo = [&](int y) { return prefixo.data() + static_cast<size_t>(y) * largura; };
+    auto linhaSufixo = [&](int y) { return sufixo.data() + static_cast<size_t>(y) * largura; };
     
-    // Calcula raio do elemento estruturante
-    int raio = elementoEstruturante.rows / 2;
+    for (int inicio = 0; inicio < linhas; inicio += k) {
+        int fim = std::min(inicio + k, linhas);
+        std::copy(linhaEntrada(inicio), linhaEntrada(inicio) + largura, linhaPrefixo(inicio));
+        for (int y = inicio + 1; y < fim; y++) {
+            combinarLinhas<Op>(linhaPrefixo(y - 1), linhaEntrada(y), linhaPrefixo(y), largura);
+        }
+        std::copy(linhaEntrada(fim - 1), linhaEntrada(fim - 1) + largura, linhaSufixo(fim - 1));
+        for (int y = fim - 2; y >= inicio; y--) {
+            combinarLinhas<Op>(linhaSufixo(y + 1), linhaEntrada(y), linhaSufixo(y), largura);
+        }
+    }
+    
+    for (int y = saidaInicio; y < saidaFim; y++) {
+        combinarLinhas<Op>(linhaSufixo(y + a), linhaPrefixo(y + b), linhaSaida(y), largura);
+    }
+}
+
+/**
+ * Aloca a saída (reaproveitando a memória se o tamanho já confere) e zera só
+ * a faixa de borda de largura "raio"; o interior é escrito pelo operador.
+ * @return false se a imagem não tem interior (saída toda zerada)
+ */
+static bool prepararSaida(cv::Mat& resultado, cv::Size tamanho, int raio) {
+    resultado.create(tamanho, CV_8UC1);
+    bool temInterior = tamanho.height > 2 * raio && tamanho.width > 2 * raio;
+    for (int y = 0; y < tamanho.height; y++) {
+        uchar* linha = resultado.ptr<uchar>(y);
+        if (!temInterior || y < raio || y >= tamanho.height - raio) {
+            std::fill(linha, linha + tamanho.width, 0);
+        } else {
+            std::fill(linha, linha + raio, 0);
+            std::fill(linha + tamanho.width - raio, linha + tamanho.width, 0);
+        }
+    }
+    return temInterior;
+}
+
+/**
+ * Retângulo cheio (deslocamentos relativos ao centro): passada horizontal e
+ * vertical de van Herk/Gil-Werman; com SIMD, a horizontal de janelas até
+ * JANELA_MAXIMA_DUPLICACAO pixels é feita por duplicação. Só o interior
+ * [raio, n - raio) é calculado; a faixa de borda fica zerada.
+ */
+template <typename Op>
+static void minMaxRetangulo(const cv::Mat& imagem, const cv::Rect& janela, int raio, cv::Mat& resultado) {
+    if (!prepararSaida(resultado, imagem.size(), raio)) {
+        return;
+    }
+    int x0 = janela.x;
+    int x1 = janela.x + janela.width - 1;
+    int y0 = janela.y;
+    int y1 = janela.y + janela.height - 1;
     
-    // Aplica erosão
-    for (int y = raio; y < imagemBinaria.rows - raio; y++) {
-        for (int x = raio; x < imagemBinaria.cols - raio; x++) {
-            // Se o elemento estruturante encaixa completamente, mantém o pixel
-            if (encaixaCompletamente(imagemBinaria, y, x, elementoEstruturante)) {
-                resultado.at<uchar>(y, x) = 255;
+    // Passada horizontal: linha a linha, em faixas paralelas
+    bool duplicacao = Simd::nivelAtivo() != NivelSimd::ESCALAR && janela.width <= JANELA_MAXIMA_DUPLICACAO;
+    cv::Mat horizontal(imagem.size(), CV_8UC1);
+    ExecutorParalelo::executarFaixas(imagem.rows, [&](int inicio, int fim) {
+        std::vector<uchar> prefixo(imagem.cols), sufixo(imagem.cols);
+        for (int y = inicio; y < fim; y++) {
+            if (duplicacao) {
+                duplicacaoLinha<Op>(imagem.ptr<uchar>(y), horizontal.ptr<uchar>(y), imagem.cols, x0, x1,
+                                    raio, imagem.cols - raio, prefixo.data(), sufixo.data());
             } else {
-                resultado.at<uchar>(y, x) = 0;
+                vanHerkLinha<Op>(imagem.ptr<uchar>(y), horizontal.ptr<uchar>(y), imagem.cols, x0, x1,
+                                 raio, imagem.cols - raio, prefixo.data(), sufixo.data());
+            }
+        }
+    });
+    
+    // Passada vertical: faixas de colunas (só as que recebem resultado)
+    ExecutorParalelo::executarFaixas(imagem.cols - 2 * raio, [&](int inicio, int fim) {
+        int colunaInicio = raio + inicio;
+        vanHerkVertical<Op, uchar>(imagem.rows, fim - inicio, y0, y1, raio, imagem.rows - raio,
+            [&](int y) { return horizontal.ptr<uchar>(y) + colunaInicio; },
+            [&](int y) { return resultado.ptr<uchar>(y) + colunaInicio; });
+    }, 64);
+}
+
+/**
+ * Elemento qualquer por tabelas de cordas (Urbach-Wilkinson): para cada linha
+ * da imagem, a tabela de comprimento L guarda op(linha[x .. x + L - 1]); o
+ * resultado é op, sobre as cordas (dy, dx, L), de tabela_L[y + dy][x + dx].
+ * Cada faixa mantém um anel com as tabelas das linhas que o elemento alcança,
+ * e ao avançar uma linha calcula apenas as tabelas da linha nova.
+ */
+template <typename Op>
+static void minMaxCordas(const cv::Mat& imagem, const PlanoElemento& plano, cv::Mat& resultado) {
+    int raio = plano.raio;
+    if (!prepararSaida(resultado, imagem.size(), raio)) {
+        return;
+    }
+    
+    int dyMinimo = plano.cordas.front().dy;
+    int dyMaximo = plano.cordas.back().dy;
+    int tamanhoAnel = dyMaximo - dyMinimo + 1;
+    int numeroTabelas = static_cast<int>(plano.comprimentos.size());
+    int colunas = imagem.cols;
+    
+    // Índice da tabela de cada corda
+    std::vector<int> tabelaDaCorda;
+    for (const Corda& corda : plano.cordas) {
+        int indice = static_cast<int>(std::find(plano.comprimentos.begin(), plano.comprimentos.end(),
+                                                corda.comprimento) - plano.comprimentos.begin());
+        tabelaDaCorda.push_back(indice);
+    }
+    
+    ExecutorParalelo::executarFaixas(imagem.rows - 2 * raio, [&](int inicio, int fim) {
+        std::vector<uchar> anel(static_cast<size_t>(tamanhoAnel) * numeroTabelas * colunas);
+        auto tabela = [&](int yy, int indice) {
+            int slot = ((yy % tamanhoAnel) + tamanhoAnel) % tamanhoAnel;
+            return anel.data() + (static_cast<size_t>(slot) * numeroTabelas + indice) * colunas;
+        };
+        
+        auto preencher = [&](int yy) {
+            const uchar* origem = imagem.ptr<uchar>(yy);
+            std::copy(origem, origem + colunas, tabela(yy, 0));
+            for (int i = 1; i < numeroTabelas; i++) {
+                int p = plano.predecessor[i];
+                int passo = plano.comprimentos[i] - plano.comprimentos[p];
+                const uchar* anterior = tabela(yy, p);
+                uchar* destino = tabela(yy, i);
+                int limite = colunas - passo;
+                combinarLinhas<Op>(anterior, anterior + passo, destino, std::max(limite, 0));
+                // Posições onde a corda sairia da linha: nunca lidas no interior
+                std::copy(anterior + std::max(limite, 0), anterior + colunas, destino + std::max(limite, 0));
+            }
+        };
+        
+        int proximaLinha = raio + inicio + dyMinimo;
+        for (int y = raio + inicio; y < raio + fim; y++) {
+            while (proximaLinha <= y + dyMaximo) {
+                preencher(proximaLinha++);
+            }
+            
+            uchar* destino = resultado.ptr<uchar>(y);
+            for (size_t c = 0; c < plano.cordas.size(); c++) {
+                const Corda& corda = plano.cordas[c];
+                const uchar* origem = tabela(y + corda.dy, tabelaDaCorda[c]) + corda.dx;
+                if (c == 0) {
+                    std::copy(origem + raio, origem + colunas - raio, destino + raio);
+                    continue;
+                }
+                combinarLinhas<Op>(destino + raio, origem + raio, destino + raio, colunas - 2 * raio);
+            }
+        }
+    });
+}
+
+// Distância (ao quadrado) quando não há nenhum pixel alvo na imagem
+static const int DISTANCIA_INFINITA = std::numeric_limits<int>::max();
+
+/**
+ * Transformada de distância euclidiana exata (Felzenszwalb-Huttenlocher):
+ * distância ao quadrado de cada pixel ao pixel mais próximo com valor "alvo".
+ * 1) Colunas: distância vertical ao alvo mais próximo (varredura para baixo
+ *    e para cima), em faixas de colunas paralelas.
+ * 2) Linhas: envoltória inferior das parábolas (x - q)² + f(q), em faixas
+ *    de linhas paralelas. As duas passadas são lineares no número de pixels.
+ * @param distancia Saída CV_32S (DISTANCIA_INFINITA se não houver alvo)
+ */
+static void distanciaQuadrada(const cv::Mat& binaria, uchar alvo, cv::Mat& distancia) {
+    int linhas = binaria.rows;
+    int colunas = binaria.cols;
+    distancia.create(binaria.size(), CV_32S);
+    
+    ExecutorParalelo::executarFaixas(colunas, [&](int inicio, int fim) {
+        int largura = fim - inicio;
+        std::vector<int> ultimo(largura, -1);
+        for (int y = 0; y < linhas; y++) {
+            const uchar* origem = binaria.ptr<uchar>(y) + inicio;
+            int* destino = distancia.ptr<int>(y) + inicio;
+            for (int i = 0; i < largura; i++) {
+                if (origem[i] == alvo) {
+                    ultimo[i] = y;
+                }
+                destino[i] = (ultimo[i] < 0) ? -1 : y - ultimo[i];
+            }
+        }
+        std::fill(ultimo.begin(), ultimo.end(), -1);
+        for (int y = linhas - 1; y >= 0; y--) {
+            const uchar* origem = binaria.ptr<uchar>(y) + inicio;
+            int* destino = distancia.ptr<int>(y) + inicio;
+            for (int i = 0; i < largura; i++) {
+                if (origem[i] == alvo) {
+                    ultimo[i] = y;
+                }
+                if (ultimo[i] >= 0 && (destino[i] < 0 || ultimo[i] - y < destino[i])) {
+                    destino[i] = ultimo[i] - y;
+                }
+                destino[i] = (destino[i] < 0) ? DISTANCIA_INFINITA : destino[i] * destino[i];
+            }
+        }
+    }, 64);
+    
+    ExecutorParalelo::executarFaixas(linhas, [&](int inicio, int fim) {
+        std::vector<int> f(colunas);
+        std::vector<int> v(colunas);              // vértices das parábolas da envoltória
+        std::vector<double> z(colunas + 1);       // limites entre parábolas consecutivas
+        const double infinito = std::numeric_limits<double>::infinity();
+        
+        for (int y = inicio; y < fim; y++) {
+            int* linha = distancia.ptr<int>(y);
+            std::copy(linha, linha + colunas, f.begin());
+            
+            int k = -1;
+            for (int q = 0; q < colunas; q++) {
+                if (f[q] == DISTANCIA_INFINITA) {
+                    continue;
+                }
+                if (k < 0) {
+                    k = 0;
+                    v[0] = q;
+                    z[0] = -infinito;
+                    z[1] = infinito;
+                    continue;
+                }
+                // Interseção com a última parábola; descarta as que ficam por cima
+                double s;
+                while (true) {
+                    int p = v[k];
+                    s = (static_cast<double>(f[q]) + static_cast<double>(q) * q -
+                         static_cast<double>(f[p]) - static_cast<double>(p) * p) / (2.0 * (q - p));
+                    if (s > z[k]) {
+                        break;
+                    }
+                    k--;
+                }
+                k++;
+                v[k] = q;
+                z[k] = s;
+                z[k + 1] = infinito;
+            }
+            if (k < 0) {
+                continue;   // linha sem nenhum alvo na mesma coluna: já é infinita
+            }
+            
+            k = 0;
+            for (int x = 0; x < colunas; x++) {
+                while (z[k + 1] < x) {
+                    k++;
+                }
+                int dx = x - v[k];
+                linha[x] = dx * dx + f[v[k]];
+            }
+        }
+    });
+}
+
+/**
+ * Erosão/dilatação por disco como limiar da transformada de distância:
+ * erosão mantém o pixel se o fundo mais próximo está a mais de raioDisco;
+ * dilatação liga o pixel se algum objeto está a até raioDisco
+ */
+template <typename Op>
+static void morfologiaDisco(const cv::Mat& imagem, const PlanoElemento& plano, cv::Mat& resultado) {
+    int raio = plano.raio;
+    if (!prepararSaida(resultado, imagem.size(), raio)) {
+        return;
+    }
+    
+    cv::Mat distancia;
+    distanciaQuadrada(imagem, Op::EH_MINIMO ? 0 : 255, distancia);
+    int limite = plano.raioDisco * plano.raioDisco;
+    
+    ExecutorParalelo::executarFaixas(imagem.rows - 2 * raio, [&](int inicio, int fim) {
+        for (int y = raio + inicio; y < raio + fim; y++) {
+            const int* origem = distancia.ptr<int>(y);
+            uchar* destino = resultado.ptr<uchar>(y);
+            for (int x = raio; x < imagem.cols - raio; x++) {
+                bool ligado = Op::EH_MINIMO ? (origem[x] > limite) : (origem[x] <= limite);
+                destino[x] = ligado ? 255 : 0;
             }
         }
+    });
+}
+
+/**
+ * Executa um plano do PlanejadorElementoEstruturante (exceto força bruta).
+ * "resultado" não pode ser a própria imagem de entrada.
+ */
+template <typename Op>
+static void executarPlanoOp(const cv::Mat& imagem, const PlanoElemento& plano, cv::Mat& resultado) {
+    switch (plano.tipo) {
+        case TipoPlano::RETANGULO:
+            minMaxRetangulo<Op>(imagem, plano.retangulos[0], plano.raio, resultado);
+            return;
+        
+        case TipoPlano::UNIAO_RETANGULOS: {
+            // Erosão pela união = mínimo das erosões (dilatação: máximo)
+            minMaxRetangulo<Op>(imagem, plano.retangulos[0], plano.raio, resultado);
+            cv::Mat parcial;
+            for (size_t i = 1; i < plano.retangulos.size(); i++) {
+                minMaxRetangulo<Op>(imagem, plano.retangulos[i], plano.raio, parcial);
+                ExecutorParalelo::executarFaixas(resultado.rows, [&](int inicio, int fim) {
+                    for (int y = inicio; y < fim; y++) {
+                        combinarLinhas<Op>(resultado.ptr<uchar>(y), parcial.ptr<uchar>(y),
+                                           resultado.ptr<uchar>(y), resultado.cols);
+                    }
+                }, 64);
+            }
+            return;
+        }
+        
+        case TipoPlano::CADEIA: {
+            // Erosão por A (+) B = erosão por B da erosão por A. Cada etapa
+            // acerta o seu interior, que contém tudo que a etapa seguinte lê.
+            // Duas áreas de trabalho alternam entre entrada e saída.
+            cv::Mat trabalho[2];
+            const cv::Mat* atual = &imagem;
+            for (size_t i = 0; i < plano.etapas.size(); i++) {
+                cv::Mat& saida = trabalho[i % 2];
+                executarPlanoOp<Op>(*atual, *plano.etapas[i], saida);
+                atual = &saida;
+            }
+            // A cadeia pode ser menor que o elemento: zera a faixa do elemento
+            if (!prepararSaida(resultado, imagem.size(), plano.raio)) {
+                return;
+            }
+            for (int y = plano.raio; y < imagem.rows - plano.raio; y++) {
+                const uchar* origem = atual->ptr<uchar>(y);
+                std::copy(origem + plano.raio, origem + imagem.cols - plano.raio,
+                          resultado.ptr<uchar>(y) + plano.raio);
+            }
+            return;
+        }
+        
+        case TipoPlano::DISCO:
+            morfologiaDisco<Op>(imagem, plano, resultado);
+            return;
+        
+        case TipoPlano::CORDAS:
+        default:
+            minMaxCordas<Op>(imagem, plano, resultado);
+            return;
+    }
+}
+
+/**
+ * acumulador[x] = op(acumulador[x], linha[x + deslocamento]) para uma linha
+ * compactada de "palavras" palavras; pixels fora da linha contam como 0.
+ * Com deslocamento >= 0 pode ser feito no próprio vetor (acumulador == linha):
+ * cada palavra só lê ela mesma e palavras seguintes, ainda não alteradas.
+ */
+template <typename Op>
+static void combinarDeslocada(uint64_t* acumulador, const uint64_t* linha, int palavras, int deslocamento) {
+    int q = (deslocamento >= 0 ? deslocamento : -deslocamento) >> 6;
+    int r = (deslocamento >= 0 ? deslocamento : -deslocamento) & 63;
+    
+    if (deslocamento >= 0) {
+        for (int p = 0; p < palavras; p++) {
+            uint64_t baixo = (p + q < palavras) ? linha[p + q] : 0;
+            uint64_t alto = (p + q + 1 < palavras) ? linha[p + q + 1] : 0;
+            uint64_t deslocada = (r == 0) ? baixo : (baixo >> r) | (alto << (64 - r));
+            acumulador[p] = Op::aplicar(acumulador[p], deslocada);
+        }
+    } else {
+        for (int p = 0; p < palavras; p++) {
+            uint64_t alto = (p - q >= 0) ? linha[p - q] : 0;
+            uint64_t baixo = (p - q - 1 >= 0) ? linha[p - q - 1] : 0;
+            uint64_t deslocada = (r == 0) ? alto : (alto << r) | (baixo >> (64 - r));
+            acumulador[p] = Op::aplicar(acumulador[p], deslocada);
+        }
     }
+}
+
+/**
+ * Erosão (OperacaoMinimo) ou dilatação (OperacaoMaximo) compactada com
+ * elemento qualquer: para cada célula do elemento, a linha vizinha é deslocada
+ * e combinada palavra a palavra (64 pixels por operação).
+ */
+template <typename Op>
+static ImagemBinariaCompactada morfologiaCompactadaGeral(const ImagemBinariaCompactada& imagem,
+                                                         const cv::Mat& ee) {
+    int raio = ee.rows / 2;
+    int palavras = imagem.palavrasPorLinha();
+    ImagemBinariaCompactada resultado(imagem.linhas(), imagem.colunas());
+    
+    std::vector<uint64_t> mascara(palavras);
+    imagem.mascaraColunas(raio, imagem.colunas() - raio, mascara.data());
+    
+    ExecutorParalelo::executarFaixas(imagem.linhas() - 2 * raio, [&](int inicio, int fim) {
+        for (int y = raio + inicio; y < raio + fim; y++) {
+            uint64_t* destino = resultado.linha(y);
+            std::fill(destino, destino + palavras, Op::NEUTRO);
+            for (int ky = -raio; ky <= raio; ky++) {
+                for (int kx = -raio; kx <= raio; kx++) {
+                    if (ee.at<uchar>(ky + raio, kx + raio) == 1) {
+                        combinarDeslocada<Op>(destino, imagem.linha(y + ky), palavras, kx);
+                    }
+                }
+            }
+            for (int p = 0; p < palavras; p++) {
+                destino[p] &= mascara[p];
+            }
+        }
+    });
     
     return resultado;
 }
 
-cv::Mat MorfologiaMatematica::dilatacao(const cv::Mat& imagem, const cv::Mat& elementoEstruturante) {
-    // Converte para binária se necessário
-    cv::Mat imagemBinaria = converterParaBinaria(imagem);
+/**
+ * Caso do quadrado cheio: segmento horizontal por duplicação (a janela de
+ * comprimento n vira 2n com um deslocamento, log2(k) passos por linha) e
+ * segmento vertical por van Herk/Gil-Werman sobre palavras inteiras.
+ */
+template <typename Op>
+static ImagemBinariaCompactada morfologiaCompactadaQuadrado(const ImagemBinariaCompactada& imagem,
+                                                            int raio) {
+    int k = 2 * raio + 1;
+    int palavras = imagem.palavrasPorLinha();
+    ImagemBinariaCompactada resultado(imagem.linhas(), imagem.colunas());
+    if (imagem.linhas() < k || imagem.colunas() < k) {
+        return resultado;
+    }
     
-    // Cria imagem de saída
-    cv::Mat resultado = cv::Mat::zeros(imagemBinaria.size(), CV_8UC1);
+    // Passada horizontal: horizontal[x] = op(linha[x - raio .. x + raio])
+    ImagemBinariaCompactada horizontal(imagem.linhas(), imagem.colunas());
+    ExecutorParalelo::executarFaixas(imagem.linhas(), [&](int inicio, int fim) {
+        std::vector<uint64_t> janela(palavras);
+        for (int y = inicio; y < fim; y++) {
+            const uint64_t* origem = imagem.linha(y);
+            std::copy(origem, origem + palavras, janela.begin());
+            
+            // janela[x] = op(linha[x .. x + comprimento - 1])
+            int comprimento = 1;
+            while (2 * comprimento <= k) {
+                combinarDeslocada<Op>(janela.data(), janela.data(), palavras, comprimento);
+                comprimento *= 2;
+            }
+            
+            // Duas janelas sobrepostas cobrem [x - raio, x + raio]
+            uint64_t* destino = horizontal.linha(y);
+            std::fill(destino, destino + palavras, Op::NEUTRO);
+            combinarDeslocada<Op>(destino, janela.data(), palavras, -raio);
+            combinarDeslocada<Op>(destino, janela.data(), palavras, k - comprimento - raio);
+        }
+    });
     
-    // Calcula raio do elemento estruturante
-    int raio = elementoEstruturante.rows / 2;
+    // Passada vertical: faixas de palavras em paralelo
+    ExecutorParalelo::executarFaixas(palavras, [&](int inicio, int fim) {
+        vanHerkVertical<Op, uint64_t>(imagem.linhas(), fim - inicio, -raio, raio,
+                                      raio, imagem.linhas() - raio,
+            [&](int y) { return horizontal.linha(y) + inicio; },
+            [&](int y) { return resultado.linha(y) + inicio; });
+    }, 4);
     
-    // Aplica dilatação
-    for (int y = raio; y < imagemBinaria.rows - raio; y++) {
-        for (int x = raio; x < imagemBinaria.cols - raio; x++) {
-            // Se há alguma intersecção, ativa o pixel
-            if (temIntersecao(imagemBinaria, y, x, elementoEstruturante)) {
-                resultado.at<uchar>(y, x) = 255;
-            } else {
-                resultado.at<uchar>(y, x) = 0;
+    // Zera a faixa de borda (mesma convenção da versão em bytes)
+    std::vector<uint64_t> mascara(palavras);
+    imagem.mascaraColunas(raio, imagem.colunas() - raio, mascara.data());
+    ExecutorParalelo::executarFaixas(imagem.linhas(), [&](int inicio, int fim) {
+        for (int y = inicio; y < fim; y++) {
+            uint64_t* destino = resultado.linha(y);
+            bool linhaBorda = (y < raio || y >= imagem.linhas() - raio);
+            for (int p = 0; p < palavras; p++) {
+                destino[p] = linhaBorda ? 0 : (destino[p] & mascara[p]);
             }
         }
+    });
+    
+    return resultado;
+}
+
+/**
+ * a E NÃO b, palavra a palavra (diferença de conjuntos)
+ */
+static ImagemBinariaCompactada diferencaCompactada(const ImagemBinariaCompactada& a,
+                                                   const ImagemBinariaCompactada& b) {
+    ImagemBinariaCompactada resultado(a.linhas(), a.colunas());
+    int palavras = a.palavrasPorLinha();
+    
+    ExecutorParalelo::executarFaixas(a.linhas(), [&](int inicio, int fim) {
+        for (int y = inicio; y < fim; y++) {
+            const uint64_t* linhaA = a.linha(y);
+            const uint64_t* linhaB = b.linha(y);
+            uint64_t* destino = resultado.linha(y);
+            for (int p = 0; p < palavras; p++) {
+                destino[p] = linhaA[p] & ~linhaB[p];
+            }
+        }
+    }, 64);
+    
+    return resultado;
+}
+
+typedef ImagemBinariaRLE::Segmento Segmento;
+
+/**
+ * Interseção de duas listas de segmentos ordenadas e sem sobreposição
+ */
+static void intersecaoSegmentos(const std::vector<Segmento>& a, const std::vector<Segmento>& b,
+                                std::vector<Segmento>& saida) {
+    saida.clear();
+    size_t i = 0;
+    size_t j = 0;
+    while (i < a.size() && j < b.size()) {
+        int inicio = std::max(a[i].inicio, b[j].inicio);
+        int fim = std::min(a[i].fim, b[j].fim);
+        if (inicio < fim) {
+            saida.push_back(Segmento{inicio, fim});
+        }
+        // Avança o segmento que termina antes
+        if (a[i].fim < b[j].fim) {
+            i++;
+        } else {
+            j++;
+        }
+    }
+}
+
+/**
+ * a - b (pixels de a que não estão em b), listas ordenadas
+ */
+static void diferencaSegmentos(const Segmento* a, int na, const Segmento* b, int nb,
+                               std::vector<Segmento>& saida) {
+    saida.clear();
+    int j = 0;
+    for (int i = 0; i < na; i++) {
+        int inicio = a[i].inicio;
+        int fim = a[i].fim;
+        while (j < nb && b[j].fim <= inicio) {
+            j++;
+        }
+        // Recorta os segmentos de b que cobrem parte de [inicio, fim)
+        int k = j;
+        while (k < nb && b[k].inicio < fim) {
+            if (b[k].inicio > inicio) {
+                saida.push_back(Segmento{inicio, b[k].inicio});
+            }
+            inicio = std::max(inicio, b[k].fim);
+            k++;
+        }
+        if (inicio < fim) {
+            saida.push_back(Segmento{inicio, fim});
+        }
+    }
+}
+
+/**
+ * Ordena, funde segmentos sobrepostos ou encostados e recorta em [minimo, maximo)
+ */
+static void fundirSegmentos(std::vector<Segmento>& segmentos, int minimo, int maximo) {
+    std::sort(segmentos.begin(), segmentos.end(), [](const Segmento& a, const Segmento& b) {
+        return a.inicio < b.inicio;
+    });
+    size_t saida = 0;
+    for (const Segmento& segmento : segmentos) {
+        int inicio = std::max(segmento.inicio, minimo);
+        int fim = std::min(segmento.fim, maximo);
+        if (inicio >= fim) {
+            continue;
+        }
+        if (saida > 0 && inicio <= segmentos[saida - 1].fim) {
+            segmentos[saida - 1].fim = std::max(segmentos[saida - 1].fim, fim);
+        } else {
+            segmentos[saida++] = Segmento{inicio, fim};
+        }
     }
+    segmentos.resize(saida);
+}
+
+cv::Mat MorfologiaMatematica::erosao(const cv::Mat& imagem, const cv::Mat& elementoEstruturante) {
+    // Converte para binária se necessário
+    cv::Mat imagemBinaria = converterParaBinaria(imagem);
     
+    cv::Mat resultado;
+    erosaoBinaria(imagemBinaria, elementoEstruturante, resultado);
+    return resultado;
+}
+
+cv::Mat MorfologiaMatematica::dilatacao(const cv::Mat& imagem, const cv::Mat& elementoEstruturante) {
+    // Converte para binária se necessário
+    cv::Mat imagemBinaria = converterParaBinaria(imagem);
+    
+    cv::Mat resultado;
+    dilatacaoBinaria(imagemBinaria, elementoEstruturante, resultado);
     return resultado;
 }
 
 cv::Mat MorfologiaMatematica::abertura(const cv::Mat& imagem, const cv::Mat& elementoEstruturante) {
     // Abertura = Erosão seguida de Dilatação
-    cv::Mat erodida = erosao(imagem, elementoEstruturante);
-    cv::Mat resultado = dilatacao(erodida, elementoEstruturante);
-    return resultado;
+    ResultadosMorfologicos resultados;
+    aplicarConjunto(imagem, elementoEstruturante, ABERTURA, resultados);
+    return resultados.abertura;
 }
 
 cv::Mat MorfologiaMatematica::fechamento(const cv::Mat& imagem, const cv::Mat& elementoEstruturante) {
     // Fechamento = Dilatação seguida de Erosão
-    cv::Mat dilatada = dilatacao(imagem, elementoEstruturante);
-    cv::Mat resultado = erosao(dilatada, elementoEstruturante);
-    return resultado;
+    ResultadosMorfologicos resultados;
+    aplicarConjunto(imagem, elementoEstruturante, FECHAMENTO, resultados);
+    return resultados.fechamento;
 }
 
 cv::Mat MorfologiaMatematica::limiteInterno(const cv::Mat& imagem, const cv::Mat& elementoEstruturante) {
     // Limite Interno = Original - Erosão
-    cv::Mat imagemBinaria = converterParaBinaria(imagem);
-    cv::Mat erodida = erosao(imagemBinaria, elementoEstruturante);
+    ResultadosMorfologicos resultados;
+    aplicarConjunto(imagem, elementoEstruturante, LIMITE_INTERNO, resultados);
+    return resultados.limiteInterno;
+}
+
+cv::Mat MorfologiaMatematica::limiteExterno(const cv::Mat& imagem, const cv::Mat& elementoEstruturante) {
+    // Limite Externo = Dilatação - Original
+    ResultadosMorfologicos resultados;
+    aplicarConjunto(imagem, elementoEstruturante, LIMITE_EXTERNO, resultados);
+    return resultados.limiteExterno;
+}
+
+void MorfologiaMatematica::aplicarConjunto(const cv::Mat& imagem, const cv::Mat& elementoEstruturante,
+                                           int operacoes, ResultadosMorfologicos& resultados) {
+    // Binarização única, compartilhada por todas as saídas
+    binarizar(imagem, resultados.binaria, 128);
+    const cv::Mat& binaria = resultados.binaria;
     
-    cv::Mat resultado = cv::Mat::zeros(imagemBinaria.size(), CV_8UC1);
+    // Cada erosão/dilatação da imagem é calculada uma única vez
+    if (operacoes & (EROSAO | ABERTURA | LIMITE_INTERNO)) {
+        erosaoBinaria(binaria, elementoEstruturante, resultados.erosao);
+    }
+    if (operacoes & (DILATACAO | FECHAMENTO | LIMITE_EXTERNO)) {
+        dilatacaoBinaria(binaria, elementoEstruturante, resultados.dilatacao);
+    }
     
-    // Subtração pixel a pixel
-    for (int y = 0; y < imagemBinaria.rows; y++) {
-        for (int x = 0; x < imagemBinaria.cols; x++) {
-            uchar original = imagemBinaria.at<uchar>(y, x);
-            uchar erodido = erodida.at<uchar>(y, x);
-            
-            // Se estava ativo no original mas não na erodida, é borda interna
-            if (original == 255 && erodido == 0) {
-                resultado.at<uchar>(y, x) = 255;
-            }
-        }
+    // Abertura e fechamento partem da erosão/dilatação já prontas (já binárias)
+    if (operacoes & ABERTURA) {
+        dilatacaoBinaria(resultados.erosao, elementoEstruturante, resultados.abertura);
+    }
+    if (operacoes & FECHAMENTO) {
+        erosaoBinaria(resultados.dilatacao, elementoEstruturante, resultados.fechamento);
     }
     
-    return resultado;
+    // Limites: diferenças pixel a pixel, os dois na mesma passada
+    bool interno = (operacoes & LIMITE_INTERNO) != 0;
+    bool externo = (operacoes & LIMITE_EXTERNO) != 0;
+    if (!interno && !externo) {
+        return;
+    }
+    if (interno) {
+        resultados.limiteInterno.create(binaria.size(), CV_8UC1);
+    }
+    if (externo) {
+        resultados.limiteExterno.create(binaria.size(), CV_8UC1);
+    }
+    
+    ExecutorParalelo::executarFaixas(binaria.rows, [&](int inicio, int fim) {
+        for (int y = inicio; y < fim; y++) {
+            const uchar* original = binaria.ptr<uchar>(y);
+            if (interno) {
+                // Ativo no original mas não na erodida: borda interna
+                const uchar* erodida = resultados.erosao.ptr<uchar>(y);
+                uchar* destino = resultados.limiteInterno.ptr<uchar>(y);
+                for (int x = 0; x < binaria.cols; x++) {
+                    destino[x] = original[x] & static_cast<uchar>(~erodida[x]);
+                }
+            }
+            if (externo) {
+                // Ativo na dilatada mas não no original: borda externa
+                const uchar* dilatada = resultados.dilatacao.ptr<uchar>(y);
+                uchar* destino = resultados.limiteExterno.ptr<uchar>(y);
+                for (int x = 0; x < binaria.cols; x++) {
+                    destino[x] = dilatada[x] & static_cast<uchar>(~original[x]);
+                }
+            }
+        }
+    });
 }
 
-cv::Mat MorfologiaMatematica::limiteExterno(const cv::Mat& imagem, const cv::Mat& elementoEstruturante) {
-    // Limite Externo = Dilatação - Original
-    cv::Mat imagemBinaria = converterParaBinaria(imagem);
-    cv::Mat dilatada = dilatacao(imagemBinaria, elementoEstruturante);
+void MorfologiaMatematica::erosaoBinaria(const cv::Mat& imagemBinaria, const cv::Mat& elementoEstruturante,
+                                         cv::Mat& resultado) {
+    // Calcula raio do elemento estruturante
+    int raio = elementoEstruturante.rows / 2;
     
-    cv::Mat resultado = cv::Mat::zeros(imagemBinaria.size(), CV_8UC1);
+    // Retângulos, cruzes, losangos e formas gerais têm execução mais barata
+    std::shared_ptr<const PlanoElemento> plano = PlanejadorElementoEstruturante::planejar(elementoEstruturante);
+    if (plano->tipo != TipoPlano::FORCA_BRUTA) {
+        executarPlano(imagemBinaria, *plano, true, resultado);
+        return;
+    }
     
-    // Subtração pixel a pixel
-    for (int y = 0; y < imagemBinaria.rows; y++) {
-        for (int x = 0; x < imagemBinaria.cols; x++) {
-            uchar dilatado = dilatada.at<uchar>(y, x);
-            uchar original = imagemBinaria.at<uchar>(y, x);
-            
-            // Se está ativo na dilatada mas não no original, é borda externa
-            if (dilatado == 255 && original == 0) {
-                resultado.at<uchar>(y, x) = 255;
+    // Cria imagem de saída (o laço abaixo escreve todo o interior)
+    prepararSaida(resultado, imagemBinaria.size(), raio);
+    
+    // Aplica erosão (faixas de linhas em paralelo)
+    ExecutorParalelo::executarFaixas(imagemBinaria.rows - 2 * raio, [&](int inicio, int fim) {
+        for (int y = raio + inicio; y < raio + fim; y++) {
+            for (int x = raio; x < imagemBinaria.cols - raio; x++) {
+                // Se o elemento estruturante encaixa completamente, mantém o pixel
+                if (encaixaCompletamente(imagemBinaria, y, x, elementoEstruturante)) {
+                    resultado.at<uchar>(y, x) = 255;
+                } else {
+                    resultado.at<uchar>(y, x) = 0;
+                }
             }
         }
+    });
+}
+
+void MorfologiaMatematica::dilatacaoBinaria(const cv::Mat& imagemBinaria, const cv::Mat& elementoEstruturante,
+                                            cv::Mat& resultado) {
+    // Calcula raio do elemento estruturante
+    int raio = elementoEstruturante.rows / 2;
+    
+    // Retângulos, cruzes, losangos e formas gerais têm execução mais barata
+    std::shared_ptr<const PlanoElemento> plano = PlanejadorElementoEstruturante::planejar(elementoEstruturante);
+    if (plano->tipo != TipoPlano::FORCA_BRUTA) {
+        executarPlano(imagemBinaria, *plano, false, resultado);
+        return;
     }
     
-    return resultado;
+    // Cria imagem de saída (o laço abaixo escreve todo o interior)
+    prepararSaida(resultado, imagemBinaria.size(), raio);
+    
+    // Aplica dilatação (faixas de linhas em paralelo)
+    ExecutorParalelo::executarFaixas(imagemBinaria.rows - 2 * raio, [&](int inicio, int fim) {
+        for (int y = raio + inicio; y < raio + fim; y++) {
+            for (int x = raio; x < imagemBinaria.cols - raio; x++) {
+                // Se há alguma intersecção, ativa o pixel
+                if (temIntersecao(imagemBinaria, y, x, elementoEstruturante)) {
+                    resultado.at<uchar>(y, x) = 255;
+                } else {
+                    resultado.at<uchar>(y, x) = 0;
+                }
+            }
+        }
+    });
 }
 
 cv::Mat MorfologiaMatematica::criarElementoEstruturante(int tamanho) {
@@ -145,35 +880,309 @@ cv::Mat MorfologiaMatematica::criarElementoEstruturanteCruz(int tamanho) {
     return elemento;
 }
 
-cv::Mat MorfologiaMatematica::converterParaBinaria(const cv::Mat& imagem, int limiar) {
-    cv::Mat resultado;
+cv::Mat MorfologiaMatematica::criarElementoEstruturanteDisco(int raio) {
+    if (raio < 1) {
+        std::cerr << "Erro: Raio do disco deve ser >= 1!" << std::endl;
+        raio = 1;
+    }
     
-    // Se já é binária, retorna clone
-    if (imagem.channels() == 1) {
-        resultado = imagem.clone();
-    } else {
-        // Converte para cinza primeiro
-        resultado = cv::Mat(imagem.rows, imagem.cols, CV_8UC1);
-        for (int y = 0; y < imagem.rows; y++) {
-            for (int x = 0; x < imagem.cols; x++) {
-                cv::Vec3b pixel = imagem.at<cv::Vec3b>(y, x);
-                uchar cinza = static_cast<uchar>(0.299 * pixel[2] + 0.587 * pixel[1] + 0.114 * pixel[0]);
-                resultado.at<uchar>(y, x) = cinza;
+    // Cria elemento estruturante em forma de disco (dx² + dy² <= raio²)
+    int tamanho = 2 * raio + 1;
+    cv::Mat elemento = cv::Mat::zeros(tamanho, tamanho, CV_8UC1);
+    for (int dy = -raio; dy <= raio; dy++) {
+        for (int dx = -raio; dx <= raio; dx++) {
+            if (dx * dx + dy * dy <= raio * raio) {
+                elemento.at<uchar>(dy + raio, dx + raio) = 1;
             }
         }
     }
     
-    // Aplica limiarização para garantir imagem binária
-    for (int y = 0; y < resultado.rows; y++) {
-        for (int x = 0; x < resultado.cols; x++) {
-            uchar pixel = resultado.at<uchar>(y, x);
-            resultado.at<uchar>(y, x) = (pixel > limiar) ? 255 : 0;
+    return elemento;
+}
+
+cv::Mat MorfologiaMatematica::transformadaDistancia(const cv::Mat& imagem) {
+    cv::Mat imagemBinaria = converterParaBinaria(imagem);
+    
+    // Distância ao fundo (pixels 0)
+    cv::Mat quadrada;
+    distanciaQuadrada(imagemBinaria, 0, quadrada);
+    
+    cv::Mat resultado(imagemBinaria.size(), CV_32F);
+    ExecutorParalelo::executarFaixas(resultado.rows, [&](int inicio, int fim) {
+        for (int y = inicio; y < fim; y++) {
+            const int* origem = quadrada.ptr<int>(y);
+            float* destino = resultado.ptr<float>(y);
+            for (int x = 0; x < resultado.cols; x++) {
+                destino[x] = (origem[x] == DISTANCIA_INFINITA)
+                    ? std::numeric_limits<float>::infinity()
+                    : std::sqrt(static_cast<float>(origem[x]));
+            }
         }
+    });
+    
+    return resultado;
+}
+
+cv::Mat MorfologiaMatematica::erosaoDisco(const cv::Mat& imagem, int raio) {
+    return morfologiaDiscoBinaria(imagem, raio, true);
+}
+
+cv::Mat MorfologiaMatematica::dilatacaoDisco(const cv::Mat& imagem, int raio) {
+    return morfologiaDiscoBinaria(imagem, raio, false);
+}
+
+cv::Mat MorfologiaMatematica::morfologiaDiscoBinaria(const cv::Mat& imagem, int raio, bool erosao) {
+    if (raio < 1) {
+        std::cerr << "Erro: Raio do disco deve ser >= 1!" << std::endl;
+        raio = 1;
+    }
+    cv::Mat imagemBinaria = converterParaBinaria(imagem);
+    
+    // Plano montado direto: analisar um disco grande célula a célula seria caro
+    PlanoElemento plano;
+    plano.tipo = TipoPlano::DISCO;
+    plano.raio = raio;
+    plano.raioDisco = raio;
+    plano.custoPorPixel = 0;
+    
+    cv::Mat resultado;
+    executarPlano(imagemBinaria, plano, erosao, resultado);
+    return resultado;
+}
+
+cv::Mat MorfologiaMatematica::erosaoCinza(const cv::Mat& imagem, const cv::Mat& elementoEstruturante) {
+    cv::Mat cinza;
+    if (!paraCinza(imagem, cinza)) {
+        return imagem.clone();
+    }
+    
+    cv::Mat resultado;
+    if (!morfologiaCinza(cinza, elementoEstruturante, true, resultado)) {
+        return cinza.clone();
+    }
+    return resultado;
+}
+
+cv::Mat MorfologiaMatematica::dilatacaoCinza(const cv::Mat& imagem, const cv::Mat& elementoEstruturante) {
+    cv::Mat cinza;
+    if (!paraCinza(imagem, cinza)) {
+        return imagem.clone();
     }
     
+    cv::Mat resultado;
+    if (!morfologiaCinza(cinza, elementoEstruturante, false, resultado)) {
+        return cinza.clone();
+    }
     return resultado;
 }
 
+cv::Mat MorfologiaMatematica::aberturaCinza(const cv::Mat& imagem, const cv::Mat& elementoEstruturante) {
+    cv::Mat cinza;
+    if (!paraCinza(imagem, cinza)) {
+        return imagem.clone();
+    }
+    
+    // Abertura = Erosão seguida de Dilatação pelo elemento refletido
+    cv::Mat erodida, resultado;
+    if (!morfologiaCinza(cinza, elementoEstruturante, true, erodida)) {
+        return cinza.clone();
+    }
+    morfologiaCinza(erodida, refletirElemento(elementoEstruturante), false, resultado);
+    return resultado;
+}
+
+cv::Mat MorfologiaMatematica::fechamentoCinza(const cv::Mat& imagem, const cv::Mat& elementoEstruturante) {
+    cv::Mat cinza;
+    if (!paraCinza(imagem, cinza)) {
+        return imagem.clone();
+    }
+    
+    // Fechamento = Dilatação seguida de Erosão pelo elemento refletido
+    cv::Mat dilatada, resultado;
+    if (!morfologiaCinza(cinza, elementoEstruturante, false, dilatada)) {
+        return cinza.clone();
+    }
+    morfologiaCinza(dilatada, refletirElemento(elementoEstruturante), true, resultado);
+    return resultado;
+}
+
+cv::Mat MorfologiaMatematica::topHat(const cv::Mat& imagem, const cv::Mat& elementoEstruturante) {
+    cv::Mat cinza;
+    if (!paraCinza(imagem, cinza)) {
+        return imagem.clone();
+    }
+    
+    // Top-hat = Original - Abertura
+    return subtrairSaturado(cinza, aberturaCinza(cinza, elementoEstruturante));
+}
+
+cv::Mat MorfologiaMatematica::blackHat(const cv::Mat& imagem, const cv::Mat& elementoEstruturante) {
+    cv::Mat cinza;
+    if (!paraCinza(imagem, cinza)) {
+        return imagem.clone();
+    }
+    
+    // Black-hat = Fechamento - Original
+    return subtrairSaturado(fechamentoCinza(cinza, elementoEstruturante), cinza);
+}
+
+cv::Mat MorfologiaMatematica::gradienteMorfologico(const cv::Mat& imagem, const cv::Mat& elementoEstruturante) {
+    cv::Mat cinza;
+    if (!paraCinza(imagem, cinza)) {
+        return imagem.clone();
+    }
+    
+    // Gradiente = Dilatação - Erosão
+    cv::Mat erodida, dilatada;
+    if (!morfologiaCinza(cinza, elementoEstruturante, true, erodida)) {
+        return cinza.clone();
+    }
+    morfologiaCinza(cinza, elementoEstruturante, false, dilatada);
+    return subtrairSaturado(dilatada, erodida);
+}
+
+bool MorfologiaMatematica::morfologiaCinza(const cv::Mat& cinza, const cv::Mat& elementoEstruturante,
+                                           bool minimo, cv::Mat& resultado) {
+    const cv::Mat& ee = elementoEstruturante;
+    if (ee.empty() || ee.type() != CV_8UC1 || ee.rows != ee.cols || ee.rows % 2 == 0) {
+        std::cerr << "Erro: Elemento estruturante deve ser quadrado de lado ímpar!" << std::endl;
+        return false;
+    }
+    int raio = ee.rows / 2;
+    uchar neutro = minimo ? 255 : 0;
+    
+    // Moldura de largura "raio" com o neutro da operação: a faixa de borda que
+    // os executores zeram fica toda na moldura, e os pixels de fora não influem
+    cv::Mat expandida(cinza.rows + 2 * raio, cinza.cols + 2 * raio, CV_8UC1);
+    ExecutorParalelo::executarFaixas(expandida.rows, [&](int inicio, int fim) {
+        for (int y = inicio; y < fim; y++) {
+            uchar* linha = expandida.ptr<uchar>(y);
+            if (y < raio || y >= cinza.rows + raio) {
+                std::fill(linha, linha + expandida.cols, neutro);
+                continue;
+            }
+            const uchar* origem = cinza.ptr<uchar>(y - raio);
+            std::fill(linha, linha + raio, neutro);
+            std::copy(origem, origem + cinza.cols, linha + raio);
+            std::fill(linha + raio + cinza.cols, linha + expandida.cols, neutro);
+        }
+    });
+    
+    std::shared_ptr<const PlanoElemento> plano = PlanejadorElementoEstruturante::planejar(ee);
+    resultado.create(cinza.size(), CV_8UC1);
+    
+    if (plano->tipo == TipoPlano::FORCA_BRUTA) {
+        // Elementos minúsculos ou vazios: mínimo/máximo direto das células "1"
+        std::vector<cv::Point> celulas;
+        for (int i = 0; i < ee.rows; i++) {
+            for (int j = 0; j < ee.cols; j++) {
+                if (ee.at<uchar>(i, j) == 1) {
+                    celulas.push_back(cv::Point(j, i));
+                }
+            }
+        }
+        ExecutorParalelo::executarFaixas(cinza.rows, [&](int inicio, int fim) {
+            for (int y = inicio; y < fim; y++) {
+                uchar* destino = resultado.ptr<uchar>(y);
+                for (int x = 0; x < cinza.cols; x++) {
+                    uchar valor = neutro;
+                    for (const cv::Point& celula : celulas) {
+                        uchar pixel = expandida.at<uchar>(y + celula.y, x + celula.x);
+                        valor = minimo ? std::min(valor, pixel) : std::max(valor, pixel);
+                    }
+                    destino[x] = valor;
+                }
+            }
+        });
+        return true;
+    }
+    
+    cv::Mat saida;
+    if (plano->tipo == TipoPlano::DISCO) {
+        // O limiar de distância só vale para imagens binárias: usa as cordas do plano
+        PlanoElemento cordas = *plano;
+        cordas.tipo = TipoPlano::CORDAS;
+        executarPlano(expandida, cordas, minimo, saida);
+    } else {
+        executarPlano(expandida, *plano, minimo, saida);
+    }
+    
+    // Interior da imagem expandida = imagem original
+    ExecutorParalelo::executarFaixas(cinza.rows, [&](int inicio, int fim) {
+        for (int y = inicio; y < fim; y++) {
+            const uchar* origem = saida.ptr<uchar>(y + raio) + raio;
+            std::copy(origem, origem + cinza.cols, resultado.ptr<uchar>(y));
+        }
+    });
+    return true;
+}
+
+bool MorfologiaMatematica::paraCinza(const cv::Mat& imagem, cv::Mat& cinza) {
+    if (imagem.type() == CV_8UC1) {
+        cinza = imagem;
+        return true;
+    }
+    if (imagem.type() == CV_8UC3) {
+        ConversorTonsCinza::paraMediaPonderadaUmCanal(imagem, cinza);
+        return true;
+    }
+    std::cerr << "Erro: Imagem deve ser CV_8UC1 ou BGR (CV_8UC3)!" << std::endl;
+    return false;
+}
+
+cv::Mat MorfologiaMatematica::refletirElemento(const cv::Mat& elementoEstruturante) {
+    cv::Mat refletido(elementoEstruturante.size(), elementoEstruturante.type());
+    int linhas = elementoEstruturante.rows;
+    int colunas = elementoEstruturante.cols;
+    for (int y = 0; y < linhas; y++) {
+        for (int x = 0; x < colunas; x++) {
+            refletido.at<uchar>(y, x) = elementoEstruturante.at<uchar>(linhas - 1 - y, colunas - 1 - x);
+        }
+    }
+    return refletido;
+}
+
+cv::Mat MorfologiaMatematica::subtrairSaturado(const cv::Mat& a, const cv::Mat& b) {
+    cv::Mat resultado(a.size(), CV_8UC1);
+    ExecutorParalelo::executarFaixas(a.rows, [&](int inicio, int fim) {
+        for (int y = inicio; y < fim; y++) {
+            const uchar* linhaA = a.ptr<uchar>(y);
+            const uchar* linhaB = b.ptr<uchar>(y);
+            uchar* destino = resultado.ptr<uchar>(y);
+            for (int x = 0; x < a.cols; x++) {
+                destino[x] = (linhaA[x] > linhaB[x]) ? linhaA[x] - linhaB[x] : 0;
+            }
+        }
+    });
+    return resultado;
+}
+
+cv::Mat MorfologiaMatematica::converterParaBinaria(const cv::Mat& imagem, int limiar) {
+    cv::Mat resultado;
+    binarizar(imagem, resultado, limiar);
+    return resultado;
+}
+
+void MorfologiaMatematica::binarizar(const cv::Mat& imagem, cv::Mat& resultado, int limiar) {
+    // Se já é binária, copia
+    if (imagem.channels() == 1) {
+        imagem.copyTo(resultado);
+    } else {
+        // Converte para cinza (1 canal) primeiro
+        ConversorTonsCinza::paraMediaPonderadaUmCanal(imagem, resultado);
+    }
+    
+    // Aplica limiarização para garantir imagem binária
+    ExecutorParalelo::executarFaixas(resultado.rows, [&](int inicio, int fim) {
+        for (int y = inicio; y < fim; y++) {
+            for (int x = 0; x < resultado.cols; x++) {
+                uchar pixel = resultado.at<uchar>(y, x);
+                resultado.at<uchar>(y, x) = (pixel > limiar) ? 255 : 0;
+            }
+        }
+    });
+}
+
 bool MorfologiaMatematica::encaixaCompletamente(const cv::Mat& imagem, int y, int x, const cv::Mat& ee) {
     int raio = ee.rows / 2;
     
@@ -211,3 +1220,647 @@ bool MorfologiaMatematica::temIntersecao(const cv::Mat& imagem, int y, int x, co
     
     return false; // Não tem intersecção
 }
+
+bool MorfologiaMatematica::elementoQuadradoCompleto(const cv::Mat& ee) {
+    if (ee.rows != ee.cols || ee.rows % 2 == 0 || ee.type() != CV_8UC1) {
+        return false;
+    }
+    
+    for (int y = 0; y < ee.rows; y++) {
+        for (int x = 0; x < ee.cols; x++) {
+            if (ee.at<uchar>(y, x) != 1) {
+                return false;
+            }
+        }
+    }
+    
+    return true;
+}
+
+void MorfologiaMatematica::executarPlano(const cv::Mat& imagemBinaria, const PlanoElemento& plano,
+                                         bool minimo, cv::Mat& resultado) {
+    if (minimo) {
+        executarPlanoOp<OperacaoMinimo>(imagemBinaria, plano, resultado);
+    } else {
+        executarPlanoOp<OperacaoMaximo>(imagemBinaria, plano, resultado);
+    }
+}
+
+ImagemBinariaCompactada MorfologiaMatematica::erosao(const ImagemBinariaCompactada& imagem,
+                                                     const cv::Mat& elementoEstruturante) {
+    if (elementoQuadradoCompleto(elementoEstruturante)) {
+        return morfologiaCompactadaQuadrado<OperacaoMinimo>(imagem, elementoEstruturante.rows / 2);
+    }
+    return morfologiaCompactadaGeral<OperacaoMinimo>(imagem, elementoEstruturante);
+}
+
+ImagemBinariaCompactada MorfologiaMatematica::dilatacao(const ImagemBinariaCompactada& imagem,
+                                                        const cv::Mat& elementoEstruturante) {
+    if (elementoQuadradoCompleto(elementoEstruturante)) {
+        return morfologiaCompactadaQuadrado<OperacaoMaximo>(imagem, elementoEstruturante.rows / 2);
+    }
+    return morfologiaCompactadaGeral<OperacaoMaximo>(imagem, elementoEstruturante);
+}
+
+ImagemBinariaCompactada MorfologiaMatematica::abertura(const ImagemBinariaCompactada& imagem,
+                                                       const cv::Mat& elementoEstruturante) {
+    return dilatacao(erosao(imagem, elementoEstruturante), elementoEstruturante);
+}
+
+ImagemBinariaCompactada MorfologiaMatematica::fechamento(const ImagemBinariaCompactada& imagem,
+                                                         const cv::Mat& elementoEstruturante) {
+    return erosao(dilatacao(imagem, elementoEstruturante), elementoEstruturante);
+}
+
+ImagemBinariaCompactada MorfologiaMatematica::limiteInterno(const ImagemBinariaCompactada& imagem,
+                                                            const cv::Mat& elementoEstruturante) {
+    return diferencaCompactada(imagem, erosao(imagem, elementoEstruturante));
+}
+
+ImagemBinariaCompactada MorfologiaMatematica::limiteExterno(const ImagemBinariaCompactada& imagem,
+                                                            const cv::Mat& elementoEstruturante) {
+    return diferencaCompactada(dilatacao(imagem, elementoEstruturante), imagem);
+}
+
+ImagemBinariaRLE MorfologiaMatematica::erosao(const ImagemBinariaRLE& imagem,
+                                              const cv::Mat& elementoEstruturante) {
+    int raio = elementoEstruturante.rows / 2;
+    std::vector<Corda> cordas = PlanejadorElementoEstruturante::extrairCordas(elementoEstruturante);
+    std::vector<std::vector<Segmento>> porLinha(imagem.linhas());
+    if (imagem.linhas() <= 2 * raio || imagem.colunas() <= 2 * raio) {
+        return ImagemBinariaRLE(imagem.linhas(), imagem.colunas());
+    }
+    
+    // Pixel (y, x) sobrevive se cada corda (dy, dx, L) cabe num segmento da
+    // linha y + dy: para o segmento [s, e), x em [s - dx, e - dx - L + 1).
+    // O resultado é a interseção dessas listas, corda a corda.
+    ExecutorParalelo::executarFaixas(imagem.linhas() - 2 * raio, [&](int inicio, int fim) {
+        std::vector<Segmento> atual, candidatos, interseccao;
+        for (int y = raio + inicio; y < raio + fim; y++) {
+            atual.assign(1, Segmento{raio, imagem.colunas() - raio});
+            for (const Corda& corda : cordas) {
+                candidatos.clear();
+                const Segmento* segmentos = imagem.segmentos(y + corda.dy);
+                for (int i = 0; i < imagem.numeroSegmentos(y + corda.dy); i++) {
+                    if (segmentos[i].fim - segmentos[i].inicio >= corda.comprimento) {
+                        candidatos.push_back(Segmento{segmentos[i].inicio - corda.dx,
+                                                      segmentos[i].fim - corda.dx - corda.comprimento + 1});
+                    }
+                }
+                intersecaoSegmentos(atual, candidatos, interseccao);
+                atual.swap(interseccao);
+                if (atual.empty()) {
+                    break;
+                }
+            }
+            porLinha[y] = atual;
+        }
+    });
+    
+    return ImagemBinariaRLE::deLinhas(imagem.linhas(), imagem.colunas(), porLinha);
+}
+
+ImagemBinariaRLE MorfologiaMatematica::dilatacao(const ImagemBinariaRLE& imagem,
+                                                 const cv::Mat& elementoEstruturante) {
+    int raio = elementoEstruturante.rows / 2;
+    std::vector<Corda> cordas = PlanejadorElementoEstruturante::extrairCordas(elementoEstruturante);
+    std::vector<std::vector<Segmento>> porLinha(imagem.linhas());
+    if (imagem.linhas() <= 2 * raio || imagem.colunas() <= 2 * raio) {
+        return ImagemBinariaRLE(imagem.linhas(), imagem.colunas());
+    }
+    
+    // Cada segmento [s, e) da linha y + dy, visto pela corda (dy, dx, L),
+    // liga x em [s - dx - L + 1, e - dx); o resultado é a união de todos
+    ExecutorParalelo::executarFaixas(imagem.linhas() - 2 * raio, [&](int inicio, int fim) {
+        for (int y = raio + inicio; y < raio + fim; y++) {
+            std::vector<Segmento>& linha = porLinha[y];
+            for (const Corda& corda : cordas) {
+                const Segmento* segmentos = imagem.segmentos(y + corda.dy);
+                for (int i = 0; i < imagem.numeroSegmentos(y + corda.dy); i++) {
+                    linha.push_back(Segmento{segmentos[i].inicio - corda.dx - corda.comprimento + 1,
+                                             segmentos[i].fim - corda.dx});
+                }
+            }
+            fundirSegmentos(linha, raio, imagem.colunas() - raio);
+        }
+    });
+    
+    return ImagemBinariaRLE::deLinhas(imagem.linhas(), imagem.colunas(), porLinha);
+}
+
+/**
+ * a - b linha a linha, para as versões RLE dos limites
+ */
+static ImagemBinariaRLE diferencaRLE(const ImagemBinariaRLE& a, const ImagemBinariaRLE& b) {
+    std::vector<std::vector<Segmento>> porLinha(a.linhas());
+    ExecutorParalelo::executarFaixas(a.linhas(), [&](int inicio, int fim) {
+        for (int y = inicio; y < fim; y++) {
+            diferencaSegmentos(a.segmentos(y), a.numeroSegmentos(y),
+                               b.segmentos(y), b.numeroSegmentos(y), porLinha[y]);
+        }
+    });
+    return ImagemBinariaRLE::deLinhas(a.linhas(), a.colunas(), porLinha);
+}
+
+ImagemBinariaRLE MorfologiaMatematica::limiteInterno(const ImagemBinariaRLE& imagem,
+                                                     const cv::Mat& elementoEstruturante) {
+    return diferencaRLE(imagem, erosao(imagem, elementoEstruturante));
+}
+
+ImagemBinariaRLE MorfologiaMatematica::limiteExterno(const ImagemBinariaRLE& imagem,
+                                                     const cv::Mat& elementoEstruturante) {
+    return diferencaRLE(dilatacao(imagem, elementoEstruturante), imagem);
+}
+
+/**
+ * Reconstrução geodésica pelo algoritmo híbrido de Vincent: uma varredura
+ * raster e uma anti-raster propagam o marcador (limitado pela máscara) e a
+ * segunda já enfileira os pixels que ainda podem propagar; a fila FIFO
+ * termina o trabalho. Cada pixel entra na fila só quando o seu valor muda,
+ * então o custo não depende do tamanho dos objetos.
+ * Op propaga (máximo na reconstrução por dilatação, mínimo por erosão) e
+ * Limite prende o resultado à máscara (a operação dual).
+ * @param marcador Imagem CV_8UC1 inicial
+ * @param mascara Imagem CV_8UC1 que limita a propagação
+ * @param conectividade 4 ou 8
+ */
+template <typename Op, typename Limite>
+static cv::Mat reconstrucaoGeodesica(const cv::Mat& marcador, const cv::Mat& mascara, int conectividade) {
+    int linhas = mascara.rows;
+    int colunas = mascara.cols;
+    
+    // Moldura de 1 pixel com o neutro de Op: vizinhos fora da imagem nunca propagam
+    int largura = colunas + 2;
+    uchar neutro = static_cast<uchar>(Op::NEUTRO);
+    std::vector<uchar> j(static_cast<size_t>(linhas + 2) * largura, neutro);
+    std::vector<uchar> m(j.size(), neutro);
+    for (int y = 0; y < linhas; y++) {
+        const uchar* linhaMarcador = marcador.ptr<uchar>(y);
+        const uchar* linhaMascara = mascara.ptr<uchar>(y);
+        size_t base = static_cast<size_t>(y + 1) * largura + 1;
+        for (int x = 0; x < colunas; x++) {
+            m[base + x] = linhaMascara[x];
+            j[base + x] = Limite::aplicar(linhaMarcador[x], linhaMascara[x]);
+        }
+    }
+    
+    // Vizinhos já visitados na varredura raster (os opostos valem na anti-raster)
+    const int anteriores8[4] = { -largura - 1, -largura, -largura + 1, -1 };
+    const int anteriores4[2] = { -largura, -1 };
+    const int* vizinhos = (conectividade == 4) ? anteriores4 : anteriores8;
+    int numeroVizinhos = (conectividade == 4) ? 2 : 4;
+    
+    for (int y = 1; y <= linhas; y++) {
+        for (int p = y * largura + 1; p <= y * largura + colunas; p++) {
+            uchar valor = j[p];
+            for (int i = 0; i < numeroVizinhos; i++) {
+                valor = Op::aplicar(valor, j[p + vizinhos[i]]);
+            }
+            j[p] = Limite::aplicar(valor, m[p]);
+        }
+    }
+    
+    std::vector<int> fila;
+    for (int y = linhas; y >= 1; y--) {
+        for (int p = y * largura + colunas; p >= y * largura + 1; p--) {
+            uchar valor = j[p];
+            for (int i = 0; i < numeroVizinhos; i++) {
+                valor = Op::aplicar(valor, j[p - vizinhos[i]]);
+            }
+            valor = Limite::aplicar(valor, m[p]);
+            j[p] = valor;
+            for (int i = 0; i < numeroVizinhos; i++) {
+                int q = p - vizinhos[i];
+                if (Op::aplicar(j[q], valor) != j[q] && j[q] != m[q]) {
+                    fila.push_back(p);
+                    break;
+                }
+            }
+        }
+    }
+    
+    // Fila FIFO sobre um vetor: os pixels são consumidos na ordem de chegada
+    for (size_t cabeca = 0; cabeca < fila.size(); cabeca++) {
+        int p = fila[cabeca];
+        uchar valor = j[p];
+        for (int i = 0; i < numeroVizinhos; i++) {
+            for (int q : { p + vizinhos[i], p - vizinhos[i] }) {
+                if (Op::aplicar(j[q], valor) != j[q] && j[q] != m[q]) {
+                    j[q] = Limite::aplicar(valor, m[q]);
+                    fila.push_back(q);
+                }
+            }
+        }
+    }
+    
+    cv::Mat resultado(linhas, colunas, CV_8UC1);
+    for (int y = 0; y < linhas; y++) {
+        std::copy(j.begin() + static_cast<size_t>(y + 1) * largura + 1,
+                  j.begin() + static_cast<size_t>(y + 1) * largura + 1 + colunas,
+                  resultado.ptr<uchar>(y));
+    }
+    return resultado;
+}
+
+/**
+ * Combina pixel a pixel duas imagens binárias do mesmo tamanho (destino = Op(destino, outra))
+ */
+template <typename Op>
+static void combinarImagens(cv::Mat& destino, const cv::Mat& outra) {
+    ExecutorParalelo::executarFaixas(destino.rows, [&](int inicio, int fim) {
+        for (int y = inicio; y < fim; y++) {
+            combinarLinhas<Op>(destino.ptr<uchar>(y), outra.ptr<uchar>(y), destino.ptr<uchar>(y), destino.cols);
+        }
+    });
+}
+
+/**
+ * Pinta com "valor" a faixa de largura "raio" junto à borda da imagem
+ */
+static void preencherMoldura(cv::Mat& imagem, int raio, uchar valor) {
+    for (int y = 0; y < imagem.rows; y++) {
+        uchar* linha = imagem.ptr<uchar>(y);
+        if (y < raio || y >= imagem.rows - raio) {
+            std::fill(linha, linha + imagem.cols, valor);
+        } else {
+            std::fill(linha, linha + raio, valor);
+            std::fill(linha + imagem.cols - raio, linha + imagem.cols, valor);
+        }
+    }
+}
+
+/**
+ * Verifica conectividade (4 ou 8); valores inválidos viram 8
+ */
+static int validarConectividade(int conectividade) {
+    if (conectividade != 4 && conectividade != 8) {
+        std::cerr << "Erro: Conectividade deve ser 4 ou 8!" << std::endl;
+        return 8;
+    }
+    return conectividade;
+}
+
+/**
+ * Verifica se marcador e máscara podem ser usados juntos
+ */
+static bool tamanhosCompativeis(const cv::Mat& marcador, const cv::Mat& mascara) {
+    if (marcador.size() != mascara.size()) {
+        std::cerr << "Erro: Marcador e mascara devem ter o mesmo tamanho!" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+cv::Mat MorfologiaMatematica::reconstrucaoPorDilatacao(const cv::Mat& marcador, const cv::Mat& mascara,
+                                                       int conectividade) {
+    cv::Mat mascaraBinaria = converterParaBinaria(mascara);
+    if (!tamanhosCompativeis(marcador, mascara)) {
+        return mascaraBinaria;
+    }
+    cv::Mat marcadorBinario = converterParaBinaria(marcador);
+    
+    return reconstrucaoGeodesica<OperacaoMaximo, OperacaoMinimo>(
+        marcadorBinario, mascaraBinaria, validarConectividade(conectividade));
+}
+
+cv::Mat MorfologiaMatematica::reconstrucaoPorErosao(const cv::Mat& marcador, const cv::Mat& mascara,
+                                                    int conectividade) {
+    cv::Mat mascaraBinaria = converterParaBinaria(mascara);
+    if (!tamanhosCompativeis(marcador, mascara)) {
+        return mascaraBinaria;
+    }
+    cv::Mat marcadorBinario = converterParaBinaria(marcador);
+    
+    return reconstrucaoGeodesica<OperacaoMinimo, OperacaoMaximo>(
+        marcadorBinario, mascaraBinaria, validarConectividade(conectividade));
+}
+
+cv::Mat MorfologiaMatematica::dilatacaoGeodesica(const cv::Mat& marcador, const cv::Mat& mascara,
+                                                 const cv::Mat& elementoEstruturante, int iteracoes) {
+    cv::Mat mascaraBinaria = converterParaBinaria(mascara);
+    cv::Mat resultado = converterParaBinaria(marcador);
+    if (!tamanhosCompativeis(marcador, mascara)) {
+        return resultado;
+    }
+    
+    // δg(f) = min(δ(f), g), repetida; o primeiro min garante f <= g.
+    // O marcador vive numa moldura de fundo: a faixa zerada da dilatação cai
+    // fora da imagem e a borda propaga como na reconstrução
+    int raio = elementoEstruturante.rows / 2;
+    cv::Rect interior(raio, raio, resultado.cols, resultado.rows);
+    cv::Mat atual = cv::Mat::zeros(resultado.rows + 2 * raio, resultado.cols + 2 * raio, CV_8UC1);
+    cv::Mat atualInterior = atual(interior);
+    resultado.copyTo(atualInterior);
+    combinarImagens<OperacaoMinimo>(atualInterior, mascaraBinaria);
+    cv::Mat dilatada;
+    for (int i = 0; i < iteracoes; i++) {
+        dilatacaoBinaria(atual, elementoEstruturante, dilatada);
+        cv::Mat dilatadaInterior = dilatada(interior);
+        combinarImagens<OperacaoMinimo>(dilatadaInterior, mascaraBinaria);
+        std::swap(atual, dilatada);
+    }
+    return atual(interior).clone();
+}
+
+cv::Mat MorfologiaMatematica::erosaoGeodesica(const cv::Mat& marcador, const cv::Mat& mascara,
+                                              const cv::Mat& elementoEstruturante, int iteracoes) {
+    cv::Mat mascaraBinaria = converterParaBinaria(mascara);
+    cv::Mat resultado = converterParaBinaria(marcador);
+    if (!tamanhosCompativeis(marcador, mascara)) {
+        return resultado;
+    }
+    
+    // εg(f) = max(ε(f), g), repetida; o primeiro max garante f >= g.
+    // Moldura de objeto (dual da dilatação): a faixa que a erosão zera é
+    // repintada a cada passo, e o fundo de fora da imagem não avança
+    int raio = elementoEstruturante.rows / 2;
+    cv::Rect interior(raio, raio, resultado.cols, resultado.rows);
+    cv::Mat atual(resultado.rows + 2 * raio, resultado.cols + 2 * raio, CV_8UC1, cv::Scalar(255));
+    cv::Mat atualInterior = atual(interior);
+    resultado.copyTo(atualInterior);
+    combinarImagens<OperacaoMaximo>(atualInterior, mascaraBinaria);
+    cv::Mat erodida;
+    for (int i = 0; i < iteracoes; i++) {
+        erosaoBinaria(atual, elementoEstruturante, erodida);
+        preencherMoldura(erodida, raio, 255);
+        cv::Mat erodidaInterior = erodida(interior);
+        combinarImagens<OperacaoMaximo>(erodidaInterior, mascaraBinaria);
+        std::swap(atual, erodida);
+    }
+    return atual(interior).clone();
+}
+
+cv::Mat MorfologiaMatematica::preencherBuracos(const cv::Mat& imagem, int conectividade) {
+    cv::Mat imagemBinaria = converterParaBinaria(imagem);
+    conectividade = validarConectividade(conectividade);
+    
+    // Fundo que alcança a borda da imagem (com a conectividade dual à do objeto);
+    // o resto do fundo são buracos
+    cv::Mat fundo(imagemBinaria.size(), CV_8UC1);
+    cv::Mat marcador = cv::Mat::zeros(imagemBinaria.size(), CV_8UC1);
+    for (int y = 0; y < imagemBinaria.rows; y++) {
+        const uchar* origem = imagemBinaria.ptr<uchar>(y);
+        uchar* linhaFundo = fundo.ptr<uchar>(y);
+        uchar* linhaMarcador = marcador.ptr<uchar>(y);
+        bool bordaVertical = (y == 0 || y == imagemBinaria.rows - 1);
+        for (int x = 0; x < imagemBinaria.cols; x++) {
+            linhaFundo[x] = 255 - origem[x];
+            if (bordaVertical || x == 0 || x == imagemBinaria.cols - 1) {
+                linhaMarcador[x] = linhaFundo[x];
+            }
+        }
+    }
+    
+    cv::Mat fundoExterno = reconstrucaoGeodesica<OperacaoMaximo, OperacaoMinimo>(
+        marcador, fundo, conectividade == 8 ? 4 : 8);
+    
+    // Objeto + buracos = tudo que não é fundo externo
+    ExecutorParalelo::executarFaixas(imagemBinaria.rows, [&](int inicio, int fim) {
+        for (int y = inicio; y < fim; y++) {
+            uchar* linha = fundoExterno.ptr<uchar>(y);
+            for (int x = 0; x < imagemBinaria.cols; x++) {
+                linha[x] = 255 - linha[x];
+            }
+        }
+    });
+    return fundoExterno;
+}
+
+cv::Mat MorfologiaMatematica::limparBorda(const cv::Mat& imagem, int conectividade) {
+    cv::Mat imagemBinaria = converterParaBinaria(imagem);
+    conectividade = validarConectividade(conectividade);
+    
+    // Marcador: pixels do objeto que ficam na borda da imagem
+    cv::Mat marcador = cv::Mat::zeros(imagemBinaria.size(), CV_8UC1);
+    for (int y = 0; y < imagemBinaria.rows; y++) {
+        const uchar* origem = imagemBinaria.ptr<uchar>(y);
+        uchar* linhaMarcador = marcador.ptr<uchar>(y);
+        if (y == 0 || y == imagemBinaria.rows - 1) {
+            std::copy(origem, origem + imagemBinaria.cols, linhaMarcador);
+        } else if (imagemBinaria.cols > 0) {
+            linhaMarcador[0] = origem[0];
+            linhaMarcador[imagemBinaria.cols - 1] = origem[imagemBinaria.cols - 1];
+        }
+    }
+    
+    // Objetos que tocam a borda, removidos da imagem
+    cv::Mat tocaBorda = reconstrucaoGeodesica<OperacaoMaximo, OperacaoMinimo>(
+        marcador, imagemBinaria, conectividade);
+    ExecutorParalelo::executarFaixas(imagemBinaria.rows, [&](int inicio, int fim) {
+        for (int y = inicio; y < fim; y++) {
+            uchar* linha = imagemBinaria.ptr<uchar>(y);
+            const uchar* linhaBorda = tocaBorda.ptr<uchar>(y);
+            for (int x = 0; x < imagemBinaria.cols; x++) {
+                linha[x] = linha[x] & ~linhaBorda[x];
+            }
+        }
+    });
+    return imagemBinaria;
+}
+
+cv::Mat MorfologiaMatematica::acertoOuErro(const cv::Mat& imagem, const cv::Mat& elementoObjeto,
+                                           const cv::Mat& elementoFundo) {
+    cv::Mat imagemBinaria = converterParaBinaria(imagem);
+    
+    cv::Mat complemento(imagemBinaria.size(), CV_8UC1);
+    ExecutorParalelo::executarFaixas(imagemBinaria.rows, [&](int inicio, int fim) {
+        for (int y = inicio; y < fim; y++) {
+            const uchar* origem = imagemBinaria.ptr<uchar>(y);
+            uchar* destino = complemento.ptr<uchar>(y);
+            for (int x = 0; x < imagemBinaria.cols; x++) {
+                destino[x] = 255 - origem[x];
+            }
+        }
+    });
+    
+    // Acerto no objeto E acerto no fundo
+    cv::Mat acerto, erro;
+    erosaoBinaria(imagemBinaria, elementoObjeto, acerto);
+    erosaoBinaria(complemento, elementoFundo, erro);
+    combinarImagens<OperacaoMinimo>(acerto, erro);
+    return acerto;
+}
+
+ImagemBinariaCompactada MorfologiaMatematica::acertoOuErro(const ImagemBinariaCompactada& imagem,
+                                                           const cv::Mat& elementoObjeto,
+                                                           const cv::Mat& elementoFundo) {
+    int palavras = imagem.palavrasPorLinha();
+    uint64_t mascaraUltima = imagem.mascaraUltimaPalavra();
+    
+    // Complemento palavra a palavra; bits além da última coluna continuam zerados
+    ImagemBinariaCompactada complemento(imagem.linhas(), imagem.colunas());
+    ExecutorParalelo::executarFaixas(imagem.linhas(), [&](int inicio, int fim) {
+        for (int y = inicio; y < fim; y++) {
+            const uint64_t* origem = imagem.linha(y);
+            uint64_t* destino = complemento.linha(y);
+            for (int p = 0; p < palavras; p++) {
+                destino[p] = ~origem[p];
+            }
+            destino[palavras - 1] &= mascaraUltima;
+        }
+    }, 64);
+    
+    ImagemBinariaCompactada acerto = erosao(imagem, elementoObjeto);
+    ImagemBinariaCompactada erro = erosao(complemento, elementoFundo);
+    ExecutorParalelo::executarFaixas(imagem.linhas(), [&](int inicio, int fim) {
+        for (int y = inicio; y < fim; y++) {
+            combinarLinhas<OperacaoMinimo>(acerto.linha(y), erro.linha(y), acerto.linha(y), palavras);
+        }
+    }, 64);
+    return acerto;
+}
+
+/**
+ * Código da vizinhança 8 de p numa imagem 0/1 com moldura: vizinhos P2..P9
+ * (norte, nordeste, leste, ..., noroeste, no sentido horário) nos bits 0..7
+ */
+static inline int codigoVizinhanca(const uchar* pixels, int p, int largura) {
+    return pixels[p - largura] |
+           (pixels[p - largura + 1] << 1) |
+           (pixels[p + 1] << 2) |
+           (pixels[p + largura + 1] << 3) |
+           (pixels[p + largura] << 4) |
+           (pixels[p + largura - 1] << 5) |
+           (pixels[p - 1] << 6) |
+           (pixels[p - largura - 1] << 7);
+}
+
+/**
+ * remover[s][codigo] = 1 se um pixel do objeto com essa vizinhança sai na subiteração s
+ */
+struct TabelasAfinamento {
+    uchar remover[2][256];
+};
+
+static TabelasAfinamento montarTabelasAfinamento(MorfologiaMatematica::MetodoAfinamento metodo) {
+    TabelasAfinamento tabelas;
+    for (int codigo = 0; codigo < 256; codigo++) {
+        // P[2..9] como na notação dos artigos
+        int P[10];
+        for (int i = 0; i < 8; i++) {
+            P[i + 2] = (codigo >> i) & 1;
+        }
+        
+        if (metodo == MorfologiaMatematica::GUO_HALL) {
+            int C = ((1 - P[2]) & (P[3] | P[4])) + ((1 - P[4]) & (P[5] | P[6])) +
+                    ((1 - P[6]) & (P[7] | P[8])) + ((1 - P[8]) & (P[9] | P[2]));
+            int N1 = (P[9] | P[2]) + (P[3] | P[4]) + (P[5] | P[6]) + (P[7] | P[8]);
+            int N2 = (P[2] | P[3]) + (P[4] | P[5]) + (P[6] | P[7]) + (P[8] | P[9]);
+            int N = std::min(N1, N2);
+            bool candidato = (C == 1) && (N >= 2) && (N <= 3);
+            tabelas.remover[0][codigo] = candidato && ((P[6] | P[7] | (1 - P[9])) & P[8]) == 0;
+            tabelas.remover[1][codigo] = candidato && ((P[2] | P[3] | (1 - P[5])) & P[4]) == 0;
+        } else {
+            int B = 0;
+            int A = 0;
+            for (int i = 2; i <= 9; i++) {
+                B += P[i];
+                int seguinte = (i == 9) ? P[2] : P[i + 1];
+                A += (P[i] == 0 && seguinte == 1) ? 1 : 0;
+            }
+            bool candidato = (B >= 2) && (B <= 6) && (A == 1);
+            tabelas.remover[0][codigo] = candidato && (P[2] * P[4] * P[6] == 0) && (P[4] * P[6] * P[8] == 0);
+            tabelas.remover[1][codigo] = candidato && (P[2] * P[4] * P[8] == 0) && (P[2] * P[6] * P[8] == 0);
+        }
+    }
+    return tabelas;
+}
+
+static const TabelasAfinamento& tabelasAfinamento(MorfologiaMatematica::MetodoAfinamento metodo) {
+    static const TabelasAfinamento zhangSuen = montarTabelasAfinamento(MorfologiaMatematica::ZHANG_SUEN);
+    static const TabelasAfinamento guoHall = montarTabelasAfinamento(MorfologiaMatematica::GUO_HALL);
+    return (metodo == MorfologiaMatematica::GUO_HALL) ? guoHall : zhangSuen;
+}
+
+cv::Mat MorfologiaMatematica::afinamento(const cv::Mat& imagem, MetodoAfinamento metodo) {
+    cv::Mat imagemBinaria = converterParaBinaria(imagem);
+    int linhas = imagemBinaria.rows;
+    int colunas = imagemBinaria.cols;
+    const TabelasAfinamento& tabelas = tabelasAfinamento(metodo);
+    
+    // Imagem 0/1 com moldura de fundo: vizinhos sempre válidos
+    int largura = colunas + 2;
+    std::vector<uchar> pixels(static_cast<size_t>(linhas + 2) * largura, 0);
+    for (int y = 0; y < linhas; y++) {
+        const uchar* origem = imagemBinaria.ptr<uchar>(y);
+        uchar* destino = pixels.data() + static_cast<size_t>(y + 1) * largura + 1;
+        for (int x = 0; x < colunas; x++) {
+            destino[x] = origem[x] ? 1 : 0;
+        }
+    }
+    const int vizinhos[8] = { -largura - 1, -largura, -largura + 1, -1, 1, largura - 1, largura, largura + 1 };
+    
+    // Pixels a avaliar em cada subiteração; o bit s de "marcas" indica que o
+    // pixel já está em pendentes[s]. Um pixel só volta para a lista quando um
+    // vizinho é removido: com a vizinhança igual, a decisão também seria igual.
+    std::vector<int> pendentes[2];
+    std::vector<uchar> marcas(pixels.size(), 0);
+    for (int y = 1; y <= linhas; y++) {
+        for (int p = y * largura + 1; p <= y * largura + colunas; p++) {
+            // Sem vizinho de fundo (código 255) nenhuma das regras remove
+            if (pixels[p] && codigoVizinhanca(pixels.data(), p, largura) != 255) {
+                pendentes[0].push_back(p);
+                pendentes[1].push_back(p);
+                marcas[p] = 3;
+            }
+        }
+    }
+    
+    std::vector<uchar> remover;
+    std::vector<int> removidos;
+    int s = 0;
+    while (!pendentes[0].empty() || !pendentes[1].empty()) {
+        std::vector<int>& atual = pendentes[s];
+        
+        // Em ordem de linha, as faixas da lista são faixas de linhas da imagem.
+        // Todas as decisões da subiteração usam a imagem de antes dela.
+        std::sort(atual.begin(), atual.end());
+        remover.assign(atual.size(), 0);
+        ExecutorParalelo::executarFaixas(static_cast<int>(atual.size()), [&](int inicio, int fim) {
+            for (int i = inicio; i < fim; i++) {
+                int p = atual[i];
+                remover[i] = pixels[p] && tabelas.remover[s][codigoVizinhanca(pixels.data(), p, largura)];
+            }
+        }, 1024);
+        
+        removidos.clear();
+        for (size_t i = 0; i < atual.size(); i++) {
+            marcas[atual[i]] &= static_cast<uchar>(~(1 << s));
+            if (remover[i]) {
+                removidos.push_back(atual[i]);
+            }
+        }
+        atual.clear();
+        
+        for (int p : removidos) {
+            pixels[p] = 0;
+        }
+        for (int p : removidos) {
+            for (int v : vizinhos) {
+                int q = p + v;
+                if (!pixels[q]) {
+                    continue;
+                }
+                for (int t = 0; t < 2; t++) {
+                    if (!(marcas[q] & (1 << t))) {
+                        marcas[q] |= static_cast<uchar>(1 << t);
+                        pendentes[t].push_back(q);
+                    }
+                }
+            }
+        }
+        s ^= 1;
+    }
+    
+    cv::Mat resultado(linhas, colunas, CV_8UC1);
+    ExecutorParalelo::executarFaixas(linhas, [&](int inicio, int fim) {
+        for (int y = inicio; y < fim; y++) {
+            const uchar* origem = pixels.data() + static_cast<size_t>(y + 1) * largura + 1;
+            uchar* destino = resultado.ptr<uchar>(y);
+            for (int x = 0; x < colunas; x++) {
+                destino[x] = origem[x] ? 255 : 0;
+            }
+        }
+    });
+    return resultado;
+}
@@ -1,8 +1,32 @@
 #include "OperacoesConvolucao.hpp"
+#include "ConversorTonsCinza.hpp"
+#include "Simd.hpp"
+#include "ExecutorParalelo.hpp"
 #include <cmath>
 #include <iostream>
+#include <algorithm>
 
-cv::Mat OperacoesConvolucao::aplicarConvolucao(const cv::Mat& imagem, const cv::Mat& kernel) {
+// Constantes do modelo de custo da FFT (em unidades de uma multiplicação-soma
+// da convolução direta), medidas empiricamente
+static const double CUSTO_BORBOLETA_FFT = 12.0;
+static const double CUSTO_PRODUTO_FFT = 10.0;
+
+// Custo de uma multiplicação-soma em ponto fixo relativo à versão em double
+static const double CUSTO_MAC_INTEIRO_ESCALAR = 0.6;
+static const double CUSTO_MAC_INTEIRO_128 = 0.16;
+static const double CUSTO_MAC_INTEIRO_AVX2 = 0.08;
+
+// Erro máximo aceito (em níveis de cinza) ao quantizar o kernel para ponto fixo
+static const double TOLERANCIA_QUANTIZACAO = 0.5;
+
+// Altura mínima de uma faixa da FFT: cada faixa recalcula o espectro do kernel
+// e processa k-1 linhas a mais, então faixas baixas desperdiçam trabalho
+static int linhasMinimasFFT(int tamanhoKernel) {
+    return std::max(64, 8 * (tamanhoKernel - 1));
+}
+
+cv::Mat OperacoesConvolucao::aplicarConvolucao(const cv::Mat& imagem, const cv::Mat& kernel,
+                                               ModoBorda borda, uchar valorConstante) {
     // Valida o kernel
     if (!validarKernel(kernel)) {
         std::cerr << "Erro: Kernel inválido! Deve ser quadrado e ter dimensões ímpares." << std::endl;
@@ -10,50 +34,381 @@ cv::Mat OperacoesConvolucao::aplicarConvolucao(const cv::Mat& imagem, const cv::
     }
     
     // Converte para tons de cinza se necessário
-    cv::Mat imagemCinza;
-    if (imagem.channels() == 3) {
-        imagemCinza = cv::Mat(imagem.rows, imagem.cols, CV_8UC1);
-        for (int y = 0; y < imagem.rows; y++) {
-            for (int x = 0; x < imagem.cols; x++) {
-                cv::Vec3b pixel = imagem.at<cv::Vec3b>(y, x);
-                // Média ponderada para conversão RGB -> Cinza
-                uchar cinza = static_cast<uchar>(0.299 * pixel[2] + 0.587 * pixel[1] + 0.114 * pixel[0]);
-                imagemCinza.at<uchar>(y, x) = cinza;
-            }
-        }
+    cv::Mat imagemCinza = converterParaCinza(imagem);
+    
+    // Copia o kernel para um vetor contíguo (linha a linha)
+    int tamanhoKernel = kernel.rows;
+    std::vector<double> coeficientes = extrairCoeficientes(kernel);
+    
+    // Cria imagem de saída
+    cv::Mat resultado(imagemCinza.size(), CV_8UC1);
+    
+    // Kernel uniforme (média): somas deslizantes, custo independente do tamanho
+    bool uniforme = coeficientes[0] != 0.0;
+    for (size_t i = 1; i < coeficientes.size() && uniforme; i++) {
+        uniforme = std::abs(coeficientes[i] - coeficientes[0]) <= 1e-12 * std::abs(coeficientes[0]);
+    }
+    
+    // Kernels de posto 1 rodam em duas passadas 1-D
+    std::vector<double> coluna, linha;
+    if (tamanhoKernel > 1 && uniforme) {
+        ExecutorParalelo::executarFaixas(imagemCinza.rows, [&](int inicio, int fim) {
+            somaDeslizante(imagemCinza, tamanhoKernel, coeficientes[0], borda, valorConstante,
+                           resultado, inicio, fim);
+        }, 4 * tamanhoKernel);
+    } else if (tamanhoKernel > 1 && decomporSeparavel(coeficientes, tamanhoKernel, coluna, linha)) {
+        ExecutorParalelo::executarFaixas(imagemCinza.rows, [&](int inicio, int fim) {
+            convolucaoSeparavel(imagemCinza, coluna, linha, borda, valorConstante,
+                                resultado, inicio, fim);
+        }, 2 * tamanhoKernel);
     } else {
-        imagemCinza = imagem.clone();
+        // Ponto fixo quando a quantização é fiel; senão soma em double
+        std::vector<short> coeficientesInteiros;
+        int deslocamento = 0;
+        bool pontoFixo = quantizarKernel(coeficientes, coeficientesInteiros, deslocamento);
+        
+        // O custo de cada multiplicação-soma direta depende do caminho (double, inteiro, SIMD)
+        double custoMac = pontoFixo ? custoRelativoMacInteiro() : 1.0;
+        
+        if (compensaFFT(tamanhoKernel, imagemCinza.rows, imagemCinza.cols, custoMac)) {
+            ExecutorParalelo::executarFaixas(imagemCinza.rows, [&](int inicio, int fim) {
+                convolucaoFFT(imagemCinza, coeficientes, tamanhoKernel, borda, valorConstante,
+                              resultado, inicio, fim);
+            }, linhasMinimasFFT(tamanhoKernel));
+        } else if (pontoFixo) {
+            ExecutorParalelo::executarFaixas(imagemCinza.rows, [&](int inicio, int fim) {
+                convolucaoInteira(imagemCinza, coeficientesInteiros, tamanhoKernel, deslocamento,
+                                  borda, valorConstante, resultado, inicio, fim);
+            }, 2 * tamanhoKernel);
+        } else {
+            ExecutorParalelo::executarFaixas(imagemCinza.rows, [&](int inicio, int fim) {
+                convolucaoDireta(imagemCinza, coeficientes, tamanhoKernel, borda, valorConstante,
+                                 resultado, inicio, fim);
+            }, 2 * tamanhoKernel);
+        }
     }
     
-    // Cria imagem de saída
-    cv::Mat resultado = cv::Mat::zeros(imagemCinza.size(), CV_8UC1);
+    return resultado;
+}
+
+cv::Mat OperacoesConvolucao::aplicarConvolucaoFFT(const cv::Mat& imagem, const cv::Mat& kernel,
+                                                  ModoBorda borda, uchar valorConstante) {
+    if (!validarKernel(kernel)) {
+        std::cerr << "Erro: Kernel inválido! Deve ser quadrado e ter dimensões ímpares." << std::endl;
+        return imagem.clone();
+    }
+    
+    cv::Mat imagemCinza = converterParaCinza(imagem);
+    cv::Mat resultado(imagemCinza.size(), CV_8UC1);
+    
+    std::vector<double> coeficientes = extrairCoeficientes(kernel);
+    ExecutorParalelo::executarFaixas(imagemCinza.rows, [&](int inicio, int fim) {
+        convolucaoFFT(imagemCinza, coeficientes, kernel.rows, borda, valorConstante,
+                      resultado, inicio, fim);
+    }, linhasMinimasFFT(kernel.rows));
+    
+    return resultado;
+}
+
+cv::Mat OperacoesConvolucao::filtroMedia(const cv::Mat& imagem, int tamanho,
+                                         ModoBorda borda, uchar valorConstante) {
+    if (tamanho % 2 == 0 || tamanho < 1) {
+        std::cerr << "Erro: Tamanho do kernel deve ser ímpar!" << std::endl;
+        return imagem.clone();
+    }
+    
+    cv::Mat imagemCinza = converterParaCinza(imagem);
+    cv::Mat resultado(imagemCinza.size(), CV_8UC1);
+    
+    ExecutorParalelo::executarFaixas(imagemCinza.rows, [&](int inicio, int fim) {
+        somaDeslizante(imagemCinza, tamanho, 1.0 / (tamanho * tamanho), borda, valorConstante,
+                       resultado, inicio, fim);
+    }, 4 * tamanho);
+    
+    return resultado;
+}
+
+void OperacoesConvolucao::somaDeslizante(const cv::Mat& imagemCinza, int tamanhoKernel, double fator,
+                                         ModoBorda borda, uchar valorConstante,
+                                         cv::Mat& resultado, int linhaInicio, int linhaFim) {
+    int raio = tamanhoKernel / 2;
+    int largura = imagemCinza.cols;
+    int larguraComBorda = largura + 2 * raio;
+    
+    // Duas janelas de uma linha: a que entra (y + raio) e a que sai (y - raio - 1)
+    BufferLinhasBorda linhaEntrada(imagemCinza, 0, raio, borda, valorConstante);
+    BufferLinhasBorda linhaSaidaJanela(imagemCinza, 0, raio, borda, valorConstante);
     
+    // Soma vertical de cada coluna (com borda) dentro da janela atual
+    std::vector<int> somaColunas(larguraComBorda, 0);
+    
+    for (int yy = linhaInicio - raio; yy <= linhaInicio + raio; yy++) {
+        linhaEntrada.posicionar(yy);
+        const uchar* pixels = linhaEntrada.linha(0) - raio;
+        for (int x = 0; x < larguraComBorda; x++) {
+            somaColunas[x] += pixels[x];
+        }
+    }
+    
+    for (int y = linhaInicio; y < linhaFim; y++) {
+        if (y > linhaInicio) {
+            // Desliza a janela vertical: soma a linha nova e remove a antiga
+            linhaEntrada.posicionar(y + raio);
+            linhaSaidaJanela.posicionar(y - raio - 1);
+            const uchar* entra = linhaEntrada.linha(0) - raio;
+            const uchar* sai = linhaSaidaJanela.linha(0) - raio;
+            for (int x = 0; x < larguraComBorda; x++) {
+                somaColunas[x] += entra[x] - sai[x];
+            }
+        }
+        
+        // Soma deslizante horizontal sobre as somas das colunas
+        long long soma = 0;
+        for (int x = 0; x < tamanhoKernel; x++) {
+            soma += somaColunas[x];
+        }
+        
+        uchar* linhaSaida = resultado.ptr<uchar>(y);
+        for (int x = 0; x < largura; x++) {
+            linhaSaida[x] = tratarOverflow(soma * fator + 1e-9);
+            if (x + 1 < largura) {
+                soma += somaColunas[x + tamanhoKernel] - somaColunas[x];
+            }
+        }
+    }
+}
+
+void OperacoesConvolucao::convolucaoDireta(const cv::Mat& imagemCinza, const std::vector<double>& coeficientes,
+                                           int tamanhoKernel, ModoBorda borda, uchar valorConstante,
+                                           cv::Mat& resultado, int linhaInicio, int linhaFim) {
     // Calcula o raio do kernel (distância do centro até a borda)
-    int raio = kernel.rows / 2;
+    int raio = tamanhoKernel / 2;
+    int largura = imagemCinza.cols;
     
-    // Aplica convolução pixel a pixel
-    for (int y = raio; y < imagemCinza.rows - raio; y++) {
-        for (int x = raio; x < imagemCinza.cols - raio; x++) {
+    // Janela de linhas já estendidas com a borda
+    BufferLinhasBorda janela(imagemCinza, raio, raio, borda, valorConstante);
+    std::vector<const uchar*> linhas(tamanhoKernel);
+    
+    for (int y = linhaInicio; y < linhaFim; y++) {
+        janela.posicionar(y);
+        for (int ky = 0; ky < tamanhoKernel; ky++) {
+            // Desloca o ponteiro para que o índice x aponte para o primeiro pixel coberto pelo kernel
+            linhas[ky] = janela.linha(ky - raio) - raio;
+        }
+        
+        uchar* linhaSaida = resultado.ptr<uchar>(y);
+        
+        for (int x = 0; x < largura; x++) {
             double soma = 0.0;
+            const double* coef = coeficientes.data();
             
-            // Aplica o kernel
-            for (int ky = -raio; ky <= raio; ky++) {
-                for (int kx = -raio; kx <= raio; kx++) {
-                    // Pega o pixel da imagem
-                    uchar pixel = imagemCinza.at<uchar>(y + ky, x + kx);
-                    // Pega o valor correspondente do kernel
-                    double kernelValor = kernel.at<double>(ky + raio, kx + raio);
-                    // Multiplica e acumula
-                    soma += pixel * kernelValor;
+            // Aplica o kernel (mesma ordem de acumulação da versão pixel a pixel)
+            for (int ky = 0; ky < tamanhoKernel; ky++) {
+                const uchar* pixels = linhas[ky] + x;
+                for (int kx = 0; kx < tamanhoKernel; kx++) {
+                    soma += pixels[kx] * coef[kx];
                 }
+                coef += tamanhoKernel;
             }
             
             // Trata overflow/underflow e armazena resultado
-            resultado.at<uchar>(y, x) = tratarOverflow(soma);
+            linhaSaida[x] = tratarOverflow(soma);
         }
     }
+}
+
+void OperacoesConvolucao::convolucaoInteira(const cv::Mat& imagemCinza, const std::vector<short>& coeficientes,
+                                            int tamanhoKernel, int deslocamento, ModoBorda borda, uchar valorConstante,
+                                            cv::Mat& resultado, int linhaInicio, int linhaFim) {
+    int raio = tamanhoKernel / 2;
+    int largura = imagemCinza.cols;
     
-    return resultado;
+    BufferLinhasBorda janela(imagemCinza, raio, raio, borda, valorConstante);
+    std::vector<const uchar*> linhas(tamanhoKernel);
+    
+    // Coeficientes em pares int16 para os núcleos SIMD (madd)
+    std::vector<int> pares = Simd::empacotarParesCoeficientes(coeficientes, tamanhoKernel);
+    
+    for (int y = linhaInicio; y < linhaFim; y++) {
+        janela.posicionar(y);
+        for (int ky = 0; ky < tamanhoKernel; ky++) {
+            linhas[ky] = janela.linha(ky - raio) - raio;
+        }
+        
+        uchar* linhaSaida = resultado.ptr<uchar>(y);
+        
+        // Núcleo vetorizado (quando disponível) e laço escalar para as colunas restantes
+        int inicioEscalar = Simd::convolucaoInteiraLinha(linhas.data(), pares.data(), tamanhoKernel,
+                                                         deslocamento, linhaSaida, largura);
+        
+        for (int x = inicioEscalar; x < largura; x++) {
+            int soma = 0;
+            const short* coef = coeficientes.data();
+            
+            for (int ky = 0; ky < tamanhoKernel; ky++) {
+                const uchar* pixels = linhas[ky] + x;
+                for (int kx = 0; kx < tamanhoKernel; kx++) {
+                    soma += pixels[kx] * coef[kx];
+                }
+                coef += tamanhoKernel;
+            }
+            
+            // Deslocamento aritmético = divisão com truncamento (mesmo critério do double)
+            int valor = (soma < 0) ? 0 : (soma >> deslocamento);
+            linhaSaida[x] = static_cast<uchar>(valor > 255 ? 255 : valor);
+        }
+    }
+}
+
+bool OperacoesConvolucao::quantizarKernel(const std::vector<double>& coeficientes,
+                                          std::vector<short>& coeficientesInteiros, int& deslocamento) {
+    double maiorCoeficiente = 0.0;
+    for (double c : coeficientes) {
+        maiorCoeficiente = std::max(maiorCoeficiente, std::abs(c));
+    }
+    if (maiorCoeficiente == 0.0) {
+        return false;
+    }
+    
+    std::vector<short> candidato(coeficientes.size());
+    double melhorErro = -1.0;
+    
+    // Procura o menor deslocamento exato; se nenhum for exato, fica com o de menor erro
+    for (int s = 0; s <= 15; s++) {
+        double escala = static_cast<double>(1 << s);
+        
+        // Coeficientes precisam caber em int16 e a soma em int32
+        if (maiorCoeficiente * escala > 32767.0) {
+            break;
+        }
+        
+        double somaAbsoluta = 0.0;
+        double erro = 0.0;
+        for (size_t i = 0; i < coeficientes.size(); i++) {
+            double q = std::round(coeficientes[i] * escala);
+            candidato[i] = static_cast<short>(q);
+            somaAbsoluta += std::abs(q);
+            erro += std::abs(q / escala - coeficientes[i]);
+        }
+        if (255.0 * somaAbsoluta > 2147483647.0) {
+            break;
+        }
+        
+        erro *= 255.0;
+        if (melhorErro < 0.0 || erro < melhorErro) {
+            melhorErro = erro;
+            coeficientesInteiros = candidato;
+            deslocamento = s;
+        }
+        if (erro == 0.0) {
+            break;
+        }
+    }
+    
+    return melhorErro >= 0.0 && melhorErro <= TOLERANCIA_QUANTIZACAO;
+}
+
+void OperacoesConvolucao::convolucaoSeparavel(const cv::Mat& imagemCinza, const std::vector<double>& coluna,
+                                              const std::vector<double>& linha, ModoBorda borda, uchar valorConstante,
+                                              cv::Mat& resultado, int linhaInicio, int linhaFim) {
+    int tamanhoKernel = static_cast<int>(linha.size());
+    int raio = tamanhoKernel / 2;
+    int largura = imagemCinza.cols;
+    
+    // Uma linha por vez: o BufferLinhasBorda também mapeia linhas fora da imagem
+    BufferLinhasBorda janela(imagemCinza, 0, raio, borda, valorConstante);
+    
+    // Anel com o resultado da passada horizontal das linhas y-raio até y+raio
+    std::vector<double> horizontal(static_cast<size_t>(tamanhoKernel) * largura);
+    std::vector<double> acumulador(largura);
+    
+    auto passadaHorizontal = [&](int yy) {
+        janela.posicionar(yy);
+        const uchar* pixels = janela.linha(0) - raio;
+        int slot = ((yy % tamanhoKernel) + tamanhoKernel) % tamanhoKernel;
+        double* destino = horizontal.data() + static_cast<size_t>(slot) * largura;
+        
+        for (int x = 0; x < largura; x++) {
+            double soma = 0.0;
+            for (int kx = 0; kx < tamanhoKernel; kx++) {
+                soma += pixels[x + kx] * linha[kx];
+            }
+            destino[x] = soma;
+        }
+    };
+    
+    for (int y = linhaInicio; y < linhaFim; y++) {
+        // Na primeira linha preenche a janela inteira; depois apenas a nova linha inferior
+        if (y == linhaInicio) {
+            for (int yy = y - raio; yy <= y + raio; yy++) {
+                passadaHorizontal(yy);
+            }
+        } else {
+            passadaHorizontal(y + raio);
+        }
+        
+        // Passada vertical sobre as linhas já filtradas
+        std::fill(acumulador.begin(), acumulador.end(), 0.0);
+        for (int ky = 0; ky < tamanhoKernel; ky++) {
+            int yy = y - raio + ky;
+            int slot = ((yy % tamanhoKernel) + tamanhoKernel) % tamanhoKernel;
+            const double* origem = horizontal.data() + static_cast<size_t>(slot) * largura;
+            double peso = coluna[ky];
+            for (int x = 0; x < largura; x++) {
+                acumulador[x] += peso * origem[x];
+            }
+        }
+        
+        // A ordem de soma difere da versão 2-D; a tolerância evita que um valor
+        // exato (ex.: 100) seja truncado para 99 por erro de arredondamento
+        uchar* linhaSaida = resultado.ptr<uchar>(y);
+        for (int x = 0; x < largura; x++) {
+            linhaSaida[x] = tratarOverflow(acumulador[x] + 1e-9);
+        }
+    }
+}
+
+bool OperacoesConvolucao::decomporSeparavel(const std::vector<double>& coeficientes, int tamanhoKernel,
+                                            std::vector<double>& coluna, std::vector<double>& linha) {
+    // Localiza o maior coeficiente em valor absoluto (pivô)
+    int linhaPivo = 0, colunaPivo = 0;
+    double maiorValor = 0.0;
+    for (int i = 0; i < tamanhoKernel; i++) {
+        for (int j = 0; j < tamanhoKernel; j++) {
+            double valor = std::abs(coeficientes[i * tamanhoKernel + j]);
+            if (valor > maiorValor) {
+                maiorValor = valor;
+                linhaPivo = i;
+                colunaPivo = j;
+            }
+        }
+    }
+    
+    if (maiorValor == 0.0) {
+        return false;
+    }
+    
+    // Candidato: linha = K[pivô, :], coluna[i] = K[i, pivô] / K[pivô, pivô]
+    double pivo = coeficientes[linhaPivo * tamanhoKernel + colunaPivo];
+    linha.assign(coeficientes.begin() + linhaPivo * tamanhoKernel,
+                 coeficientes.begin() + (linhaPivo + 1) * tamanhoKernel);
+    coluna.resize(tamanhoKernel);
+    for (int i = 0; i < tamanhoKernel; i++) {
+        coluna[i] = coeficientes[i * tamanhoKernel + colunaPivo] / pivo;
+    }
+    
+    // Todas as linhas devem ser múltiplas da linha pivô
+    double tolerancia = 1e-9 * maiorValor;
+    for (int i = 0; i < tamanhoKernel; i++) {
+        for (int j = 0; j < tamanhoKernel; j++) {
+            double reconstruido = coluna[i] * linha[j];
+            if (std::abs(reconstruido - coeficientes[i * tamanhoKernel + j]) > tolerancia) {
+                return false;
+            }
+        }
+    }
+    
+    return true;
 }
 
 cv::Mat OperacoesConvolucao::criarKernelPassaAlta(int tamanho) {
@@ -131,6 +486,183 @@ bool OperacoesConvolucao::validarKernel(const cv::Mat& kernel) {
     return true;
 }
 
+void OperacoesConvolucao::convolucaoFFT(const cv::Mat& imagemCinza, const std::vector<double>& coeficientes,
+                                        int tamanhoKernel, ModoBorda borda, uchar valorConstante,
+                                        cv::Mat& resultado, int linhaInicio, int linhaFim) {
+    typedef TransformadaFourier::Complexo Complexo;
+    
+    int raio = tamanhoKernel / 2;
+    int extra = tamanhoKernel - 1;
+    int largura = imagemCinza.cols;
+    
+    // Imagem com borda P: linha i de P corresponde à linha (linhaInicio - raio + i) da imagem
+    int larguraP = largura + extra;
+    int alturaP = (linhaFim - linhaInicio) + extra;
+    
+    // Blocos de B pixels; cada bloco convoluído ocupa B + k - 1 amostras na FFT
+    int alvo = std::max(4 * extra, 64);
+    int tamanhoFFTy = TransformadaFourier::tamanhoOtimo(std::min(alturaP, alvo) + extra);
+    int tamanhoFFTx = TransformadaFourier::tamanhoOtimo(std::min(larguraP, alvo) + extra);
+    int blocoY = tamanhoFFTy - extra;
+    int blocoX = tamanhoFFTx - extra;
+    size_t areaFFT = static_cast<size_t>(tamanhoFFTy) * tamanhoFFTx;
+    
+    TransformadaFourier planoLinhas(tamanhoFFTx);
+    TransformadaFourier planoColunas(tamanhoFFTy);
+    
+    // Espectro do kernel espelhado (a convolução do projeto é uma correlação)
+    std::vector<Complexo> espectroKernel(areaFFT, Complexo(0.0, 0.0));
+    for (int a = 0; a < tamanhoKernel; a++) {
+        for (int b = 0; b < tamanhoKernel; b++) {
+            espectroKernel[static_cast<size_t>(a) * tamanhoFFTx + b] =
+                coeficientes[(extra - a) * tamanhoKernel + (extra - b)];
+        }
+    }
+    TransformadaFourier::fft2D(espectroKernel, planoLinhas, planoColunas, false);
+    
+    // Faixa de linhas de P e acumulador da convolução completa (com k-1 linhas de sobreposição)
+    int larguraAcumulador = larguraP + extra;
+    std::vector<uchar> faixa(static_cast<size_t>(blocoY) * larguraP);
+    std::vector<double> acumulador(static_cast<size_t>(blocoY + extra) * larguraAcumulador, 0.0);
+    std::vector<Complexo> bloco(areaFFT);
+    
+    BufferLinhasBorda janela(imagemCinza, 0, raio, borda, valorConstante);
+    int blocosPorFaixa = (larguraP + blocoX - 1) / blocoX;
+    
+    for (int inicioFaixa = 0; inicioFaixa < alturaP; inicioFaixa += blocoY) {
+        int alturaFaixa = std::min(blocoY, alturaP - inicioFaixa);
+        
+        for (int i = 0; i < alturaFaixa; i++) {
+            janela.posicionar(linhaInicio - raio + inicioFaixa + i);
+            std::copy(janela.linha(0) - raio, janela.linha(0) - raio + larguraP,
+                      faixa.begin() + static_cast<size_t>(i) * larguraP);
+        }
+        
+        // Blocos processados em pares: um na parte real e outro na imaginária
+        for (int b = 0; b < blocosPorFaixa; b += 2) {
+            int inicioA = b * blocoX;
+            int larguraA = std::min(blocoX, larguraP - inicioA);
+            int inicioB = inicioA + blocoX;
+            int larguraB = (b + 1 < blocosPorFaixa) ? std::min(blocoX, larguraP - inicioB) : 0;
+            
+            std::fill(bloco.begin(), bloco.end(), Complexo(0.0, 0.0));
+            for (int i = 0; i < alturaFaixa; i++) {
+                const uchar* linhaFaixa = faixa.data() + static_cast<size_t>(i) * larguraP;
+                Complexo* linhaBloco = bloco.data() + static_cast<size_t>(i) * tamanhoFFTx;
+                for (int x = 0; x < larguraA; x++) {
+                    linhaBloco[x] = Complexo(linhaFaixa[inicioA + x], 0.0);
+                }
+                for (int x = 0; x < larguraB; x++) {
+                    linhaBloco[x] += Complexo(0.0, linhaFaixa[inicioB + x]);
+                }
+            }
+            
+            TransformadaFourier::fft2D(bloco, planoLinhas, planoColunas, false);
+            for (size_t i = 0; i < areaFFT; i++) {
+                bloco[i] *= espectroKernel[i];
+            }
+            TransformadaFourier::fft2D(bloco, planoLinhas, planoColunas, true);
+            
+            // Overlap-add: cada bloco contribui com (largura + k - 1) x (altura + k - 1) amostras
+            for (int i = 0; i < alturaFaixa + extra; i++) {
+                const Complexo* linhaBloco = bloco.data() + static_cast<size_t>(i) * tamanhoFFTx;
+                double* linhaAcumulador = acumulador.data() + static_cast<size_t>(i) * larguraAcumulador;
+                for (int x = 0; x < larguraA + extra; x++) {
+                    linhaAcumulador[inicioA + x] += linhaBloco[x].real();
+                }
+                if (larguraB > 0) {
+                    for (int x = 0; x < larguraB + extra; x++) {
+                        linhaAcumulador[inicioB + x] += linhaBloco[x].imag();
+                    }
+                }
+            }
+        }
+        
+        // As linhas iniciais do acumulador não recebem mais contribuições: grava a saída.
+        // Linha i da convolução completa corresponde à linha (linhaInicio + i - (k-1)) da saída.
+        for (int i = 0; i < alturaFaixa; i++) {
+            int y = linhaInicio + inicioFaixa + i - extra;
+            if (y < linhaInicio || y >= linhaFim) {
+                continue;
+            }
+            const double* linhaAcumulador = acumulador.data() + static_cast<size_t>(i) * larguraAcumulador + extra;
+            uchar* linhaSaida = resultado.ptr<uchar>(y);
+            for (int x = 0; x < largura; x++) {
+                // Tolerância para o erro de arredondamento da FFT
+                linhaSaida[x] = tratarOverflow(linhaAcumulador[x] + 1e-6);
+            }
+        }
+        
+        // Move a sobreposição de k-1 linhas para o topo e zera o restante
+        std::copy(acumulador.begin() + static_cast<size_t>(alturaFaixa) * larguraAcumulador,
+                  acumulador.begin() + static_cast<size_t>(alturaFaixa + extra) * larguraAcumulador,
+                  acumulador.begin());
+        std::fill(acumulador.begin() + static_cast<size_t>(extra) * larguraAcumulador, acumulador.end(), 0.0);
+    }
+}
+
+bool OperacoesConvolucao::compensaFFT(int tamanhoKernel, int linhas, int colunas, double custoMac) {
+    // Abaixo disso a soma direta sempre vence
+    if (tamanhoKernel < 9) {
+        return false;
+    }
+    
+    // Custo direto: k² multiplicações por pixel
+    double custoDireto = static_cast<double>(linhas) * colunas * tamanhoKernel * tamanhoKernel * custoMac;
+    
+    // Custo FFT: por par de blocos, duas FFTs 2-D de N log N e um produto ponto a ponto
+    int extra = tamanhoKernel - 1;
+    int alvo = std::max(4 * extra, 64);
+    int tamanhoFFTy = TransformadaFourier::tamanhoOtimo(std::min(linhas + extra, alvo) + extra);
+    int tamanhoFFTx = TransformadaFourier::tamanhoOtimo(std::min(colunas + extra, alvo) + extra);
+    double blocosY = std::ceil(static_cast<double>(linhas + extra) / (tamanhoFFTy - extra));
+    double blocosX = std::ceil(static_cast<double>(colunas + extra) / (tamanhoFFTx - extra));
+    double areaFFT = static_cast<double>(tamanhoFFTy) * tamanhoFFTx;
+    double pares = blocosY * std::ceil(blocosX / 2.0);
+    double custoFFT = pares * areaFFT * (CUSTO_BORBOLETA_FFT * std::log2(areaFFT) + CUSTO_PRODUTO_FFT);
+    
+    return custoFFT < custoDireto;
+}
+
+double OperacoesConvolucao::custoRelativoMacInteiro() {
+    switch (Simd::nivelAtivo()) {
+        case NivelSimd::AVX2:
+            return CUSTO_MAC_INTEIRO_AVX2;
+        case NivelSimd::SSE41:
+        case NivelSimd::NEON:
+            return CUSTO_MAC_INTEIRO_128;
+        case NivelSimd::ESCALAR:
+        default:
+            return CUSTO_MAC_INTEIRO_ESCALAR;
+    }
+}
+
+std::vector<double> OperacoesConvolucao::extrairCoeficientes(const cv::Mat& kernel) {
+    cv::Mat kernelDouble = kernel;
+    if (kernel.depth() != CV_64F) {
+        kernel.convertTo(kernelDouble, CV_64F);
+    }
+    
+    int tamanhoKernel = kernel.rows;
+    std::vector<double> coeficientes(tamanhoKernel * tamanhoKernel);
+    for (int ky = 0; ky < tamanhoKernel; ky++) {
+        const double* linhaKernel = kernelDouble.ptr<double>(ky);
+        for (int kx = 0; kx < tamanhoKernel; kx++) {
+            coeficientes[ky * tamanhoKernel + kx] = linhaKernel[kx];
+        }
+    }
+    return coeficientes;
+}
+
+cv::Mat OperacoesConvolucao::converterParaCinza(const cv::Mat& imagem) {
+    if (imagem.channels() == 1) {
+        // Os operadores só leem a imagem: não é preciso copiar
+        return imagem;
+    }
+    
+    return ConversorTonsCinza::paraMediaPonderadaUmCanal(imagem);
+}
+
 uchar OperacoesConvolucao::tratarOverflow(double valor) {
     if (valor > 255.0) {
         return 255;
@@ -0,0 +1,104 @@
+#include "OperacoesPontuais.hpp"
+#include "ProcessadorHistogramas.hpp"
+#include <algorithm>
+#include <iostream>
+
+static uchar saturar(int valor) {
+    return static_cast<uchar>(std::max(0, std::min(255, valor)));
+}
+
+OperacoesPontuais::OperacoesPontuais()
+    : tabelaComposta(256) {
+    for (int v = 0; v < 256; v++) {
+        tabelaComposta[v] = static_cast<uchar>(v);
+    }
+}
+
+OperacoesPontuais::OperacoesPontuais(const std::vector<uchar>& tabela)
+    : OperacoesPontuais() {
+    if (tabela.size() != 256) {
+        std::cerr << "Erro: Tabela de operação pontual deve ter 256 valores!" << std::endl;
+        return;
+    }
+    tabelaComposta = tabela;
+}
+
+template <typename Funcao>
+OperacoesPontuais& OperacoesPontuais::compor(Funcao f) {
+    // Só 256 avaliações: a imagem não é tocada até aplicar()
+    for (int v = 0; v < 256; v++) {
+        tabelaComposta[v] = f(tabelaComposta[v]);
+    }
+    return *this;
+}
+
+OperacoesPontuais& OperacoesPontuais::somar(double valor) {
+    int deslocamento = static_cast<int>(valor);
+    return compor([&](int v) { return saturar(v + deslocamento); });
+}
+
+OperacoesPontuais& OperacoesPontuais::subtrair(double valor) {
+    int deslocamento = static_cast<int>(valor);
+    return compor([&](int v) { return saturar(v - deslocamento); });
+}
+
+OperacoesPontuais& OperacoesPontuais::multiplicar(double valor) {
+    return compor([&](int v) { return saturar(static_cast<int>(v * valor)); });
+}
+
+OperacoesPontuais& OperacoesPontuais::dividir(double valor) {
+    if (valor == 0) {
+        std::cerr << "Erro: Divisão por zero!" << std::endl;
+        return *this;
+    }
+    return compor([&](int v) { return saturar(static_cast<int>(v / valor)); });
+}
+
+OperacoesPontuais& OperacoesPontuais::inverter() {
+    return compor([](int v) { return static_cast<uchar>(255 - v); });
+}
+
+OperacoesPontuais& OperacoesPontuais::limiarizar(double limiar, double valorMaximo) {
+    uchar ligado = static_cast<uchar>(valorMaximo);
+    return compor([&](int v) { return v > limiar ? ligado : static_cast<uchar>(0); });
+}
+
+OperacoesPontuais& OperacoesPontuais::encadear(const OperacoesPontuais& seguinte) {
+    const std::vector<uchar>& tabelaSeguinte = seguinte.tabelaComposta;
+    return compor([&](int v) { return tabelaSeguinte[v]; });
+}
+
+bool OperacoesPontuais::identidade() const {
+    for (int v = 0; v < 256; v++) {
+        if (tabelaComposta[v] != v) {
+            return false;
+        }
+    }
+    return true;
+}
+
+cv::Mat OperacoesPontuais::aplicar(const cv::Mat& imagem) const {
+    cv::Mat resultado;
+    aplicar(imagem, resultado);
+    return resultado;
+}
+
+void OperacoesPontuais::aplicar(const cv::Mat& imagem, cv::Mat& destino) const {
+    if (imagem.depth() != CV_8U) {
+        std::cerr << "Erro: Operações pontuais requerem imagem de 8 bits!" << std::endl;
+        destino = imagem.clone();
+        return;
+    }
+    if (identidade()) {
+        if (destino.data != imagem.data) {
+            imagem.copyTo(destino);
+        }
+        return;
+    }
+
+    // A mesma tabela vale para todos os canais: a linha é vista como um único
+    // canal de cols * canais bytes (sem cópia), no laço mais simples de aplicarTabelas
+    destino.create(imagem.rows, imagem.cols, imagem.type());
+    cv::Mat destinoUmCanal = destino.reshape(1);
+    ProcessadorHistogramas::aplicarTabelas(imagem.reshape(1), tabelaComposta, destinoUmCanal);
+}
@@ -0,0 +1,375 @@
+#include "PlanejadorElementoEstruturante.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <string>
+
+// Peso da força bruta por célula: acesso por at<>() e desvio a cada teste
+static const double PESO_FORCA_BRUTA = 2.0;
+
+// Acima disso uma união de retângulos nunca compensa frente às cordas
+static const int MAXIMO_RETANGULOS = 6;
+
+// Transformada de distância (duas passadas) + limiar, independente do raio
+static const double CUSTO_DISCO = 12.0;
+
+// Cache de planos, indexado pelo conteúdo do elemento
+static std::mutex travaCache;
+static std::map<std::string, std::shared_ptr<const PlanoElemento>> cachePlanos;
+
+static std::string chaveElemento(const cv::Mat& ee) {
+    std::string chave = std::to_string(ee.rows) + "x" + std::to_string(ee.cols) +
+                        ":" + std::to_string(ee.type()) + ":";
+    for (int y = 0; y < ee.rows; y++) {
+        const uchar* linha = ee.ptr<uchar>(y);
+        chave.append(reinterpret_cast<const char*>(linha), ee.cols * ee.elemSize());
+    }
+    return chave;
+}
+
+static bool ativo(const cv::Mat& ee, int y, int x) {
+    return ee.at<uchar>(y, x) == 1;
+}
+
+std::shared_ptr<const PlanoElemento> PlanejadorElementoEstruturante::planejar(const cv::Mat& elementoEstruturante) {
+    std::string chave = chaveElemento(elementoEstruturante);
+    {
+        std::lock_guard<std::mutex> trava(travaCache);
+        auto encontrado = cachePlanos.find(chave);
+        if (encontrado != cachePlanos.end()) {
+            return encontrado->second;
+        }
+    }
+
+    // Análise fora da trava: a cadeia planeja suas etapas recursivamente
+    std::shared_ptr<const PlanoElemento> plano = analisar(elementoEstruturante);
+
+    std::lock_guard<std::mutex> trava(travaCache);
+    auto inserido = cachePlanos.emplace(chave, plano);
+    return inserido.first->second;
+}
+
+void PlanejadorElementoEstruturante::limparCache() {
+    std::lock_guard<std::mutex> trava(travaCache);
+    cachePlanos.clear();
+}
+
+std::shared_ptr<const PlanoElemento> PlanejadorElementoEstruturante::analisar(const cv::Mat& ee) {
+    std::shared_ptr<PlanoElemento> melhor = std::make_shared<PlanoElemento>();
+    melhor->tipo = TipoPlano::FORCA_BRUTA;
+    melhor->raio = ee.rows / 2;
+
+    // Só elementos quadrados de lado ímpar têm centro bem definido
+    if (ee.empty() || ee.type() != CV_8UC1 || ee.rows != ee.cols || ee.rows % 2 == 0) {
+        melhor->custoPorPixel = ee.total() * PESO_FORCA_BRUTA;
+        return melhor;
+    }
+
+    int uns = 0;
+    for (int y = 0; y < ee.rows; y++) {
+        for (int x = 0; x < ee.cols; x++) {
+            uns += ativo(ee, y, x) ? 1 : 0;
+        }
+    }
+    melhor->custoPorPixel = uns * PESO_FORCA_BRUTA;
+    if (uns == 0) {
+        return melhor;
+    }
+
+    PlanoElemento candidato;
+    candidato.raio = melhor->raio;
+    if (planoRetangulos(ee, candidato) && candidato.custoPorPixel < melhor->custoPorPixel) {
+        *melhor = candidato;
+    }
+
+    candidato = PlanoElemento();
+    candidato.raio = melhor->raio;
+    if (planoCadeia(ee, candidato) && candidato.custoPorPixel < melhor->custoPorPixel) {
+        *melhor = candidato;
+    }
+
+    candidato = PlanoElemento();
+    candidato.raio = melhor->raio;
+    if (planoDisco(ee, candidato) && candidato.custoPorPixel < melhor->custoPorPixel) {
+        *melhor = candidato;
+    }
+
+    candidato = PlanoElemento();
+    candidato.raio = melhor->raio;
+    planoCordas(ee, candidato);
+    if (candidato.custoPorPixel < melhor->custoPorPixel) {
+        *melhor = candidato;
+    }
+
+    return melhor;
+}
+
+double PlanejadorElementoEstruturante::custoRetangulo(const cv::Rect& retangulo) {
+    // Cada passada de van Herk/Gil-Werman custa ~3 comparações por pixel; a
+    // duplicação SIMD só é usada em janelas curtas, onde sai mais barata
+    double custo = 0;
+    if (retangulo.width > 1) {
+        custo += 3;
+    }
+    if (retangulo.height > 1) {
+        custo += 3;
+    }
+    return std::max(custo, 1.0);
+}
+
+bool PlanejadorElementoEstruturante::planoRetangulos(const cv::Mat& ee, PlanoElemento& plano) {
+    int n = ee.rows;
+    int raio = n / 2;
+
+    // Candidatos: cada trecho contínuo de uma linha (ou coluna), estendido
+    // enquanto as linhas (colunas) vizinhas o contêm por inteiro
+    std::vector<cv::Rect> candidatos;
+    for (int y = 0; y < n; y++) {
+        for (int x = 0; x < n; ) {
+            if (!ativo(ee, y, x)) {
+                x++;
+                continue;
+            }
+            int x1 = x;
+            while (x1 + 1 < n && ativo(ee, y, x1 + 1)) {
+                x1++;
+            }
+            auto contem = [&](int yy) {
+                for (int xx = x; xx <= x1; xx++) {
+                    if (!ativo(ee, yy, xx)) {
+                        return false;
+                    }
+                }
+                return true;
+            };
+            int y0 = y;
+            int y1 = y;
+            while (y0 - 1 >= 0 && contem(y0 - 1)) {
+                y0--;
+            }
+            while (y1 + 1 < n && contem(y1 + 1)) {
+                y1++;
+            }
+            candidatos.push_back(cv::Rect(x, y0, x1 - x + 1, y1 - y0 + 1));
+            x = x1 + 1;
+        }
+    }
+    for (int x = 0; x < n; x++) {
+        for (int y = 0; y < n; ) {
+            if (!ativo(ee, y, x)) {
+                y++;
+                continue;
+            }
+            int y1 = y;
+            while (y1 + 1 < n && ativo(ee, y1 + 1, x)) {
+                y1++;
+            }
+            auto contem = [&](int xx) {
+                for (int yy = y; yy <= y1; yy++) {
+                    if (!ativo(ee, yy, xx)) {
+                        return false;
+                    }
+                }
+                return true;
+            };
+            int x0 = x;
+            int x1 = x;
+            while (x0 - 1 >= 0 && contem(x0 - 1)) {
+                x0--;
+            }
+            while (x1 + 1 < n && contem(x1 + 1)) {
+                x1++;
+            }
+            candidatos.push_back(cv::Rect(x0, y, x1 - x0 + 1, y1 - y + 1));
+            y = y1 + 1;
+        }
+    }
+
+    // Cobertura gulosa: a cada passo, o candidato que cobre mais células novas
+    cv::Mat coberto = cv::Mat::zeros(n, n, CV_8UC1);
+    std::vector<cv::Rect> escolhidos;
+    while (true) {
+        int melhorIndice = -1;
+        int melhorNovas = 0;
+        for (size_t i = 0; i < candidatos.size(); i++) {
+            const cv::Rect& r = candidatos[i];
+            int novas = 0;
+            for (int y = r.y; y < r.y + r.height; y++) {
+                for (int x = r.x; x < r.x + r.width; x++) {
+                    novas += coberto.at<uchar>(y, x) ? 0 : 1;
+                }
+            }
+            if (novas > melhorNovas) {
+                melhorNovas = novas;
+                melhorIndice = static_cast<int>(i);
+            }
+        }
+        if (melhorIndice < 0) {
+            break;
+        }
+        if (static_cast<int>(escolhidos.size()) == MAXIMO_RETANGULOS) {
+            return false;
+        }
+        const cv::Rect& r = candidatos[melhorIndice];
+        for (int y = r.y; y < r.y + r.height; y++) {
+            for (int x = r.x; x < r.x + r.width; x++) {
+                coberto.at<uchar>(y, x) = 1;
+            }
+        }
+        escolhidos.push_back(r);
+    }
+
+    // Custo: cada retângulo + combinação dos resultados
+    plano.tipo = (escolhidos.size() == 1) ? TipoPlano::RETANGULO : TipoPlano::UNIAO_RETANGULOS;
+    plano.custoPorPixel = static_cast<double>(escolhidos.size()) - 1;
+    plano.retangulos.clear();
+    for (const cv::Rect& r : escolhidos) {
+        plano.custoPorPixel += custoRetangulo(r);
+        plano.retangulos.push_back(cv::Rect(r.x - raio, r.y - raio, r.width, r.height));
+    }
+    return true;
+}
+
+bool PlanejadorElementoEstruturante::planoCadeia(const cv::Mat& ee, PlanoElemento& plano) {
+    int raio = ee.rows / 2;
+
+    // Losango de raio a somado a um quadrado de raio b:
+    // max(|dy| - b, 0) + max(|dx| - b, 0) <= a (a = 0 é o quadrado, já coberto)
+    for (int total = 1; total <= raio; total++) {
+        for (int a = 1; a <= total; a++) {
+            int b = total - a;
+            if (a == 1 && b == 0) {
+                continue;   // a própria cruz 3x3: nada a decompor
+            }
+            bool igual = true;
+            for (int dy = -raio; dy <= raio && igual; dy++) {
+                for (int dx = -raio; dx <= raio; dx++) {
+                    int distancia = std::max(std::abs(dy) - b, 0) + std::max(std::abs(dx) - b, 0);
+                    bool dentro = std::abs(dy) <= total && std::abs(dx) <= total && distancia <= a;
+                    if (dentro != ativo(ee, dy + raio, dx + raio)) {
+                        igual = false;
+                        break;
+                    }
+                }
+            }
+            if (!igual) {
+                continue;
+            }
+
+            plano.tipo = TipoPlano::CADEIA;
+            plano.etapas.clear();
+            if (b > 0) {
+                plano.etapas.push_back(planejar(cv::Mat::ones(2 * b + 1, 2 * b + 1, CV_8UC1)));
+            }
+            cv::Mat cruz = cv::Mat::zeros(3, 3, CV_8UC1);
+            for (int i = 0; i < 3; i++) {
+                cruz.at<uchar>(1, i) = 1;
+                cruz.at<uchar>(i, 1) = 1;
+            }
+            std::shared_ptr<const PlanoElemento> planoCruz = planejar(cruz);
+            for (int i = 0; i < a; i++) {
+                plano.etapas.push_back(planoCruz);
+            }
+
+            // Cada etapa é uma passada completa sobre a imagem intermediária
+            plano.custoPorPixel = 0;
+            for (const auto& etapa : plano.etapas) {
+                if (etapa->tipo == TipoPlano::FORCA_BRUTA || etapa->tipo == TipoPlano::CADEIA) {
+                    return false;
+                }
+                plano.custoPorPixel += etapa->custoPorPixel + 1;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+bool PlanejadorElementoEstruturante::planoDisco(const cv::Mat& ee, PlanoElemento& plano) {
+    int raio = ee.rows / 2;
+
+    // Raio do disco: maior afastamento vertical de uma célula ativa
+    int raioDisco = 0;
+    for (int y = 0; y < ee.rows; y++) {
+        for (int x = 0; x < ee.cols; x++) {
+            if (ativo(ee, y, x)) {
+                raioDisco = std::max(raioDisco, std::abs(y - raio));
+            }
+        }
+    }
+    if (raioDisco == 0) {
+        return false;
+    }
+
+    for (int dy = -raio; dy <= raio; dy++) {
+        for (int dx = -raio; dx <= raio; dx++) {
+            bool dentro = dx * dx + dy * dy <= raioDisco * raioDisco;
+            if (dentro != ativo(ee, dy + raio, dx + raio)) {
+                return false;
+            }
+        }
+    }
+
+    // As cordas acompanham o plano: o limiar de distância só vale para imagens binárias
+    planoCordas(ee, plano);
+    plano.tipo = TipoPlano::DISCO;
+    plano.raioDisco = raioDisco;
+    plano.custoPorPixel = CUSTO_DISCO;
+    return true;
+}
+
+std::vector<Corda> PlanejadorElementoEstruturante::extrairCordas(const cv::Mat& ee) {
+    int raio = ee.rows / 2;
+    std::vector<Corda> cordas;
+    for (int y = 0; y < ee.rows; y++) {
+        for (int x = 0; x < ee.cols; ) {
+            if (!ativo(ee, y, x)) {
+                x++;
+                continue;
+            }
+            int x1 = x;
+            while (x1 + 1 < ee.cols && ativo(ee, y, x1 + 1)) {
+                x1++;
+            }
+            Corda corda;
+            corda.dy = y - raio;
+            corda.dx = x - raio;
+            corda.comprimento = x1 - x + 1;
+            cordas.push_back(corda);
+            x = x1 + 1;
+        }
+    }
+    return cordas;
+}
+
+void PlanejadorElementoEstruturante::planoCordas(const cv::Mat& ee, PlanoElemento& plano) {
+    plano.tipo = TipoPlano::CORDAS;
+    plano.cordas = extrairCordas(ee);
+    std::vector<int> distintos;
+    for (const Corda& corda : plano.cordas) {
+        distintos.push_back(corda.comprimento);
+    }
+    std::sort(distintos.begin(), distintos.end());
+    distintos.erase(std::unique(distintos.begin(), distintos.end()), distintos.end());
+
+    // Comprimentos intermediários (potências de 2) garantem que cada tabela
+    // saia de uma anterior com pelo menos metade do seu comprimento
+    plano.comprimentos.assign(1, 1);
+    plano.predecessor.assign(1, -1);
+    for (int comprimento : distintos) {
+        if (comprimento == 1) {
+            continue;
+        }
+        while (2 * plano.comprimentos.back() < comprimento) {
+            plano.predecessor.push_back(static_cast<int>(plano.comprimentos.size()) - 1);
+            plano.comprimentos.push_back(2 * plano.comprimentos.back());
+        }
+        plano.predecessor.push_back(static_cast<int>(plano.comprimentos.size()) - 1);
+        plano.comprimentos.push_back(comprimento);
+    }
+
+    // Uma comparação por tabela construída e uma por corda
+    plano.custoPorPixel = static_cast<double>(plano.cordas.size()) +
+                          static_cast<double>(plano.comprimentos.size()) - 1;
+}
@@ -1,6 +1,10 @@
 #include "ProcessadorHistogramas.hpp"
+#include "ConversorTonsCinza.hpp"
+#include "ExecutorParalelo.hpp"
 #include <algorithm>
 #include <cmath>
+#include <iostream>
+#include <mutex>
 
 // Função auxiliar para arredondamento manual
 inline int roundToInt(double value) {
@@ -11,28 +15,107 @@ std::vector<cv::Mat> ProcessadorHistogramas::calcularHistograma(const cv::Mat& i
     std::vector<cv::Mat> histogramas;
     int tamanhoHist = 256;
 
-    if (imagem.channels() == 1) {
-        cv::Mat hist = cv::Mat::zeros(1, tamanhoHist, CV_32S);
-        for (int y = 0; y < imagem.rows; y++) {
-            for (int x = 0; x < imagem.cols; x++) {
-                int valor = imagem.at<uchar>(y, x);
-                hist.at<int>(valor)++;
-            }
-        }
+    if (imagem.channels() != 1 && imagem.channels() != 3) {
+        return histogramas;
+    }
+
+    // Todos os canais numa única leitura
+    std::vector<int> contagens;
+    contarHistogramas(imagem, contagens);
+    for (int c = 0; c < imagem.channels(); c++) {
+        cv::Mat hist(1, tamanhoHist, CV_32S);
+        std::copy(contagens.begin() + c * tamanhoHist, contagens.begin() + (c + 1) * tamanhoHist,
+                  hist.ptr<int>(0));
         histogramas.push_back(hist);
-    } else if (imagem.channels() == 3) {
-        for (int c = 0; c < 3; c++) {
-            cv::Mat hist = cv::Mat::zeros(1, tamanhoHist, CV_32S);
-            for (int y = 0; y < imagem.rows; y++) {
-                for (int x = 0; x < imagem.cols; x++) {
-                    int valor = imagem.at<cv::Vec3b>(y, x)[c];
-                    hist.at<int>(valor)++;
+    }
+    return histogramas;
+}
+
+void ProcessadorHistogramas::contarHistogramas(const cv::Mat& imagem, std::vector<int>& histogramas) {
+    histogramas.assign(static_cast<size_t>(imagem.channels()) * 256, 0);
+    if (imagem.depth() != CV_8U) {
+        return;
+    }
+
+    // Cada faixa conta em um histograma próprio; as contagens são somadas no fim
+    std::mutex travaHist;
+    ExecutorParalelo::executarFaixas(imagem.rows, [&](int inicio, int fim) {
+        std::vector<int> histFaixa(histogramas.size(), 0);
+        contarRegiao(imagem, inicio, fim, 0, imagem.cols, histFaixa.data());
+        std::lock_guard<std::mutex> trava(travaHist);
+        for (size_t i = 0; i < histogramas.size(); i++) {
+            histogramas[i] += histFaixa[i];
+        }
+    }, 64);
+}
+
+void ProcessadorHistogramas::contarRegiao(const cv::Mat& imagem, int linhaInicio, int linhaFim,
+                                          int colunaInicio, int colunaFim, int* contagens) {
+    int canais = imagem.channels();
+    std::vector<unsigned int> pistas(static_cast<size_t>(canais) * 256 * PISTAS, 0);
+    contarPistas(imagem, linhaInicio, linhaFim, colunaInicio, colunaFim, pistas);
+
+    // Junta as pistas: posição (256 * c + v) * PISTAS + pista
+    for (int i = 0; i < canais * 256; i++) {
+        const unsigned int* p = pistas.data() + static_cast<size_t>(i) * PISTAS;
+        contagens[i] += static_cast<int>(p[0] + p[1] + p[2] + p[3]);
+    }
+}
+
+void ProcessadorHistogramas::contarPistas(const cv::Mat& imagem, int linhaInicio, int linhaFim,
+                                          int colunaInicio, int colunaFim, std::vector<unsigned int>& pistas) {
+    int canais = imagem.channels();
+    unsigned int* h = pistas.data();
+
+    for (int y = linhaInicio; y < linhaFim; y++) {
+        const uchar* linha = imagem.ptr<uchar>(y) + colunaInicio * canais;
+        int n = colunaFim - colunaInicio;
+        int x = 0;
+
+        if (canais == 1) {
+            for (; x + 4 <= n; x += 4) {
+                h[linha[x] * PISTAS]++;
+                h[linha[x + 1] * PISTAS + 1]++;
+                h[linha[x + 2] * PISTAS + 2]++;
+                h[linha[x + 3] * PISTAS + 3]++;
+            }
+            for (; x < n; x++) {
+                h[linha[x] * PISTAS]++;
+            }
+        } else if (canais == 3) {
+            // B, G e R em tabelas separadas; pixels vizinhos em pistas diferentes
+            unsigned int* hg = h + 256 * PISTAS;
+            unsigned int* hr = h + 2 * 256 * PISTAS;
+            for (; x + 4 <= n; x += 4) {
+                const uchar* p = linha + 3 * x;
+                h[p[0] * PISTAS]++;
+                hg[p[1] * PISTAS]++;
+                hr[p[2] * PISTAS]++;
+                h[p[3] * PISTAS + 1]++;
+                hg[p[4] * PISTAS + 1]++;
+                hr[p[5] * PISTAS + 1]++;
+                h[p[6] * PISTAS + 2]++;
+                hg[p[7] * PISTAS + 2]++;
+                hr[p[8] * PISTAS + 2]++;
+                h[p[9] * PISTAS + 3]++;
+                hg[p[10] * PISTAS + 3]++;
+                hr[p[11] * PISTAS + 3]++;
+            }
+            for (; x < n; x++) {
+                const uchar* p = linha + 3 * x;
+                h[p[0] * PISTAS]++;
+                hg[p[1] * PISTAS]++;
+                hr[p[2] * PISTAS]++;
+            }
+        } else {
+            for (; x < n; x++) {
+                int pista = x & (PISTAS - 1);
+                for (int c = 0; c < canais; c++) {
+                    h[(c * 256 + linha[x * canais + c]) * PISTAS + pista]++;
                 }
             }
-            histogramas.push_back(hist);
         }
     }
-    return histogramas;
 }
 
 cv::Mat ProcessadorHistogramas::visualizarHistograma(const std::vector<cv::Mat>& histogramas) {
@@ -69,82 +152,268 @@ cv::Mat ProcessadorHistogramas::visualizarHistograma(const std::vector<cv::Mat>&
 }
 
 cv::Mat ProcessadorHistogramas::equalizarHistograma(const cv::Mat& imagem) {
-    cv::Mat resultado = imagem.clone();
-    
-    if (imagem.channels() == 1) {
-        // Calcular histograma
-        int hist[256] = {0};
-        for (int y = 0; y < imagem.rows; y++) {
-            for (int x = 0; x < imagem.cols; x++) {
-                hist[imagem.at<uchar>(y, x)]++;
-            }
-        }
+    cv::Mat resultado;
+    equalizarHistograma(imagem, resultado);
+    return resultado;
+}
 
-        // Calcular CDF (Função de Distribuição Cumulativa)
-        int cdf[256] = {0};
-        cdf[0] = hist[0];
-        for (int i = 1; i < 256; i++) {
-            cdf[i] = cdf[i - 1] + hist[i];
+void ProcessadorHistogramas::equalizarHistograma(const cv::Mat& imagem, cv::Mat& destino) {
+    if (imagem.channels() != 1 && imagem.channels() != 3) {
+        if (destino.data != imagem.data) {
+            destino = imagem.clone();
         }
+        return;
+    }
 
-        // Encontrar CDF mínimo
-        int cdfMin = 0;
-        for (int i = 0; i < 256; i++) {
-            if (cdf[i] != 0) {
-                cdfMin = cdf[i];
-                break;
-            }
+    // 1ª leitura: histogramas de todos os canais (canal c em [256 * c, 256 * c + 256))
+    std::vector<int> histogramas;
+    contarHistogramas(imagem, histogramas);
+
+    // Uma tabela por canal, lado a lado
+    int totalPixels = imagem.rows * imagem.cols;
+    std::vector<uchar> tabelas(histogramas.size());
+    for (int c = 0; c < imagem.channels(); c++) {
+        tabelaEqualizacao(histogramas.data() + 256 * c, totalPixels, tabelas.data() + 256 * c);
+    }
+
+    // 2ª leitura: as tabelas dos canais aplicadas na mesma passada
+    aplicarTabelas(imagem, tabelas, destino);
+}
+
+void ProcessadorHistogramas::tabelaEqualizacao(const int* histograma, int totalPixels, uchar* tabela) {
+    // Calcular CDF (Função de Distribuição Cumulativa)
+    int cdf[256] = {0};
+    cdf[0] = histograma[0];
+    for (int i = 1; i < 256; i++) {
+        cdf[i] = cdf[i - 1] + histograma[i];
+    }
+
+    // Encontrar CDF mínimo
+    int cdfMin = 0;
+    for (int i = 0; i < 256; i++) {
+        if (cdf[i] != 0) {
+            cdfMin = cdf[i];
+            break;
         }
+    }
 
-        // Criar tabela de lookup
-        int totalPixels = imagem.rows * imagem.cols;
-        uchar lut[256];
+    // Canal de um só valor (ou vazio): nada a redistribuir
+    if (totalPixels == cdfMin) {
         for (int i = 0; i < 256; i++) {
-            lut[i] = static_cast<uchar>(roundToInt((cdf[i] - cdfMin) * 255.0 / (totalPixels - cdfMin)));
+            tabela[i] = static_cast<uchar>(i);
         }
+        return;
+    }
 
-        // Aplicar equalização
-        for (int y = 0; y < imagem.rows; y++) {
-            for (int x = 0; x < imagem.cols; x++) {
-                resultado.at<uchar>(y, x) = lut[imagem.at<uchar>(y, x)];
+    // Criar tabela de lookup
+    for (int i = 0; i < 256; i++) {
+        tabela[i] = static_cast<uchar>(roundToInt((cdf[i] - cdfMin) * 255.0 / (totalPixels - cdfMin)));
+    }
+}
+
+void ProcessadorHistogramas::aplicarTabelas(const cv::Mat& imagem, const std::vector<uchar>& tabelas,
+                                            cv::Mat& destino) {
+    // create não realoca se destino já é a imagem: a aplicação fica no lugar
+    destino.create(imagem.rows, imagem.cols, imagem.type());
+    int canais = imagem.channels();
+
+    ExecutorParalelo::executarFaixas(imagem.rows, [&](int inicio, int fim) {
+        const uchar* t = tabelas.data();
+        for (int y = inicio; y < fim; y++) {
+            const uchar* origem = imagem.ptr<uchar>(y);
+            uchar* saida = destino.ptr<uchar>(y);
+            int n = imagem.cols * canais;
+            int i = 0;
+
+            if (canais == 1) {
+                for (; i + 4 <= n; i += 4) {
+                    saida[i] = t[origem[i]];
+                    saida[i + 1] = t[origem[i + 1]];
+                    saida[i + 2] = t[origem[i + 2]];
+                    saida[i + 3] = t[origem[i + 3]];
+                }
+                for (; i < n; i++) {
+                    saida[i] = t[origem[i]];
+                }
+            } else if (canais == 3) {
+                // B, G, R intercalados: cada byte consulta a tabela do seu canal
+                const uchar* tg = t + 256;
+                const uchar* tr = t + 512;
+                for (; i < n; i += 3) {
+                    saida[i] = t[origem[i]];
+                    saida[i + 1] = tg[origem[i + 1]];
+                    saida[i + 2] = tr[origem[i + 2]];
+                }
+            } else {
+                for (; i < n; i++) {
+                    saida[i] = t[256 * (i % canais) + origem[i]];
+                }
             }
         }
-    } else if (imagem.channels() == 3) {
-        // Equalizar cada canal separadamente
-        for (int c = 0; c < 3; c++) {
-            int hist[256] = {0};
-            for (int y = 0; y < imagem.rows; y++) {
-                for (int x = 0; x < imagem.cols; x++) {
-                    hist[imagem.at<cv::Vec3b>(y, x)[c]]++;
+    }, 64);
+}
+
+cv::Mat ProcessadorHistogramas::equalizarAdaptativo(const cv::Mat& imagem, int blocosX, int blocosY,
+                                                    double limiteCorte, bool apenasLuminancia) {
+    if (imagem.depth() != CV_8U || (imagem.channels() != 1 && imagem.channels() != 3)) {
+        std::cerr << "Erro: CLAHE requer imagem CV_8UC1 ou BGR!" << std::endl;
+        return imagem.clone();
+    }
+    if (imagem.empty()) {
+        return imagem.clone();
+    }
+    if (blocosX < 1 || blocosY < 1) {
+        std::cerr << "Erro: Grade de blocos deve ter pelo menos 1 x 1!" << std::endl;
+        blocosX = std::max(blocosX, 1);
+        blocosY = std::max(blocosY, 1);
+    }
+    // Nenhum bloco vazio
+    blocosX = std::min(blocosX, imagem.cols);
+    blocosY = std::min(blocosY, imagem.rows);
+
+    cv::Mat resultado;
+    if (imagem.channels() == 1 || !apenasLuminancia) {
+        equalizarAdaptativoCanais(imagem, blocosX, blocosY, limiteCorte, resultado);
+        return resultado;
+    }
+
+    // Só a luminância: com Cb e Cr fixos, mudar Y em d muda B, G e R em d
+    cv::Mat luminancia, equalizada;
+    ConversorTonsCinza::paraMediaPonderadaUmCanal(imagem, luminancia);
+    equalizarAdaptativoCanais(luminancia, blocosX, blocosY, limiteCorte, equalizada);
+
+    resultado.create(imagem.rows, imagem.cols, imagem.type());
+    ExecutorParalelo::executarFaixas(imagem.rows, [&](int inicio, int fim) {
+        for (int y = inicio; y < fim; y++) {
+            const uchar* origem = imagem.ptr<uchar>(y);
+            const uchar* antes = luminancia.ptr<uchar>(y);
+            const uchar* depois = equalizada.ptr<uchar>(y);
+            uchar* destino = resultado.ptr<uchar>(y);
+            for (int x = 0; x < imagem.cols; x++) {
+                int delta = depois[x] - antes[x];
+                for (int c = 0; c < 3; c++) {
+                    destino[3 * x + c] = static_cast<uchar>(std::min(std::max(origem[3 * x + c] + delta, 0), 255));
                 }
             }
+        }
+    }, 64);
+    return resultado;
+}
 
-            int cdf[256] = {0};
-            cdf[0] = hist[0];
-            for (int i = 1; i < 256; i++) {
-                cdf[i] = cdf[i - 1] + hist[i];
-            }
+void ProcessadorHistogramas::equalizarAdaptativoCanais(const cv::Mat& imagem, int blocosX, int blocosY,
+                                                       double limiteCorte, cv::Mat& destino) {
+    int canais = imagem.channels();
+    int numeroBlocos = blocosX * blocosY;
+
+    // Bloco i cobre [i * n / blocos, (i + 1) * n / blocos): tamanhos diferem em no máximo 1
+    auto inicioBloco = [](int i, int n, int blocos) {
+        return static_cast<int>(static_cast<long long>(i) * n / blocos);
+    };
 
-            int cdfMin = 0;
-            for (int i = 0; i < 256; i++) {
-                if (cdf[i] != 0) {
-                    cdfMin = cdf[i];
-                    break;
+    // 1) Tabelas: tabelas[((bloco * canais) + c) * 256 + v], blocos em paralelo
+    std::vector<uchar> tabelas(static_cast<size_t>(numeroBlocos) * canais * 256);
+    ExecutorParalelo::executarFaixas(numeroBlocos, [&](int inicio, int fim) {
+        std::vector<int> histogramas(static_cast<size_t>(canais) * 256);
+        for (int bloco = inicio; bloco < fim; bloco++) {
+            int bx = bloco % blocosX;
+            int by = bloco / blocosX;
+            int x0 = inicioBloco(bx, imagem.cols, blocosX);
+            int x1 = inicioBloco(bx + 1, imagem.cols, blocosX);
+            int y0 = inicioBloco(by, imagem.rows, blocosY);
+            int y1 = inicioBloco(by + 1, imagem.rows, blocosY);
+            int area = (x1 - x0) * (y1 - y0);
+
+            std::fill(histogramas.begin(), histogramas.end(), 0);
+            contarRegiao(imagem, y0, y1, x0, x1, histogramas.data());
+
+            int limite = std::max(1, static_cast<int>(limiteCorte * area / 256));
+            double escala = 255.0 / area;
+            for (int c = 0; c < canais; c++) {
+                int* histograma = histogramas.data() + 256 * c;
+                if (limiteCorte > 0) {
+                    cortarHistograma(histograma, limite);
+                }
+                uchar* tabela = tabelas.data() + (static_cast<size_t>(bloco) * canais + c) * 256;
+                int soma = 0;
+                for (int i = 0; i < 256; i++) {
+                    soma += histograma[i];
+                    tabela[i] = static_cast<uchar>(std::min(roundToInt(soma * escala), 255));
                 }
             }
+        }
+    }, 1);
 
-            int totalPixels = imagem.rows * imagem.cols;
-            uchar lut[256];
-            for (int i = 0; i < 256; i++) {
-                lut[i] = static_cast<uchar>(roundToInt((cdf[i] - cdfMin) * 255.0 / (totalPixels - cdfMin)));
+    // 2) Interpolação: para cada coluna (e linha), os dois blocos cujos centros a
+    // cercam e o peso do segundo; antes do primeiro centro e depois do último,
+    // um só bloco
+    struct Vizinhos {
+        int bloco0;
+        int bloco1;
+        float peso1;
+    };
+    auto vizinhos = [&](int n, int blocos) {
+        std::vector<Vizinhos> resultado(n);
+        int i = 0;
+        for (int p = 0; p < n; p++) {
+            auto centro = [&](int b) {
+                return 0.5f * (inicioBloco(b, n, blocos) + inicioBloco(b + 1, n, blocos) - 1);
+            };
+            while (i + 1 < blocos && centro(i + 1) <= p) {
+                i++;
+            }
+            if (p <= centro(0) || i + 1 >= blocos) {
+                resultado[p] = Vizinhos{i, i, 0.0f};
+            } else {
+                resultado[p] = Vizinhos{i, i + 1, (p - centro(i)) / (centro(i + 1) - centro(i))};
             }
+        }
+        return resultado;
+    };
+    std::vector<Vizinhos> porColuna = vizinhos(imagem.cols, blocosX);
+    std::vector<Vizinhos> porLinha = vizinhos(imagem.rows, blocosY);
 
-            for (int y = 0; y < imagem.rows; y++) {
-                for (int x = 0; x < imagem.cols; x++) {
-                    resultado.at<cv::Vec3b>(y, x)[c] = lut[imagem.at<cv::Vec3b>(y, x)[c]];
+    destino.create(imagem.rows, imagem.cols, imagem.type());
+    ExecutorParalelo::executarFaixas(imagem.rows, [&](int inicio, int fim) {
+        for (int y = inicio; y < fim; y++) {
+            const Vizinhos& vy = porLinha[y];
+            const uchar* origem = imagem.ptr<uchar>(y);
+            uchar* saida = destino.ptr<uchar>(y);
+            const uchar* linhaCima = tabelas.data() + static_cast<size_t>(vy.bloco0) * blocosX * canais * 256;
+            const uchar* linhaBaixo = tabelas.data() + static_cast<size_t>(vy.bloco1) * blocosX * canais * 256;
+            for (int x = 0; x < imagem.cols; x++) {
+                const Vizinhos& vx = porColuna[x];
+                size_t esquerda = static_cast<size_t>(vx.bloco0) * canais * 256;
+                size_t direita = static_cast<size_t>(vx.bloco1) * canais * 256;
+                for (int c = 0; c < canais; c++) {
+                    int v = origem[x * canais + c] + 256 * c;
+                    float cima = (1.0f - vx.peso1) * linhaCima[esquerda + v] + vx.peso1 * linhaCima[direita + v];
+                    float baixo = (1.0f - vx.peso1) * linhaBaixo[esquerda + v] + vx.peso1 * linhaBaixo[direita + v];
+                    saida[x * canais + c] = static_cast<uchar>((1.0f - vy.peso1) * cima + vy.peso1 * baixo + 0.5f);
                 }
             }
         }
+    }, 64);
+}
+
+void ProcessadorHistogramas::cortarHistograma(int* histograma, int limite) {
+    int excesso = 0;
+    for (int i = 0; i < 256; i++) {
+        if (histograma[i] > limite) {
+            excesso += histograma[i] - limite;
+            histograma[i] = limite;
+        }
+    }
+
+    // Excesso dividido igualmente; o resto vai para níveis espaçados
+    int porNivel = excesso / 256;
+    int resto = excesso - porNivel * 256;
+    for (int i = 0; i < 256; i++) {
+        histograma[i] += porNivel;
+    }
+    if (resto > 0) {
+        int passo = std::max(256 / resto, 1);
+        for (int i = 0; i < 256 && resto > 0; i += passo, resto--) {
+            histograma[i]++;
+        }
     }
-    return resultado;
 }
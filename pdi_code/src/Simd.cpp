@@ -0,0 +1,170 @@
+#include "Simd.hpp"
+#include <atomic>
+
+#if defined(PDI_SIMD_X86) && defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+// Limite configurado por limitarNivel (padrão: sem limite)
+static std::atomic<int> limiteNivel(static_cast<int>(NivelSimd::NEON));
+
+static NivelSimd detectarNivel() {
+#if defined(PDI_SIMD_X86)
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return NivelSimd::AVX2;
+    }
+    if (__builtin_cpu_supports("sse4.1")) {
+        return NivelSimd::SSE41;
+    }
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    int maiorFuncao = info[0];
+    __cpuid(info, 1);
+    bool sse41 = (info[2] & (1 << 19)) != 0;
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    bool avx2 = false;
+    if (maiorFuncao >= 7 && osxsave && avx) {
+        __cpuidex(info, 7, 0);
+        // AVX2 exige também que o sistema operacional salve os registradores YMM
+        avx2 = (info[1] & (1 << 5)) != 0 && (_xgetbv(0) & 6) == 6;
+    }
+    if (avx2) {
+        return NivelSimd::AVX2;
+    }
+    if (sse41) {
+        return NivelSimd::SSE41;
+    }
+#endif
+#elif defined(PDI_SIMD_NEON)
+    // NEON é obrigatório em ARMv8 (AArch64)
+    return NivelSimd::NEON;
+#endif
+    return NivelSimd::ESCALAR;
+}
+
+NivelSimd Simd::nivelDisponivel() {
+    static const NivelSimd nivel = detectarNivel();
+    return nivel;
+}
+
+NivelSimd Simd::nivelAtivo() {
+    NivelSimd disponivel = nivelDisponivel();
+    NivelSimd limite = static_cast<NivelSimd>(limiteNivel.load());
+
+    if (limite == NivelSimd::ESCALAR) {
+        return NivelSimd::ESCALAR;
+    }
+    if (disponivel == NivelSimd::NEON) {
+        return NivelSimd::NEON;
+    }
+    // Em x86 vale a ordem ESCALAR < SSE41 < AVX2
+    return (static_cast<int>(limite) < static_cast<int>(disponivel)) ? limite : disponivel;
+}
+
+void Simd::limitarNivel(NivelSimd nivel) {
+    limiteNivel.store(static_cast<int>(nivel));
+}
+
+const char* Simd::nome(NivelSimd nivel) {
+    switch (nivel) {
+        case NivelSimd::SSE41: return "SSE4.1";
+        case NivelSimd::AVX2:  return "AVX2";
+        case NivelSimd::NEON:  return "NEON";
+        case NivelSimd::ESCALAR:
+        default:               return "Escalar";
+    }
+}
+
+std::vector<int> Simd::empacotarParesCoeficientes(const std::vector<short>& coeficientes,
+                                                  int tamanhoKernel) {
+    int paresPorLinha = (tamanhoKernel + 1) / 2;
+    std::vector<int> pares(static_cast<size_t>(paresPorLinha) * tamanhoKernel);
+
+    for (int ky = 0; ky < tamanhoKernel; ky++) {
+        const short* linha = coeficientes.data() + ky * tamanhoKernel;
+        for (int p = 0; p < paresPorLinha; p++) {
+            int kx = 2 * p;
+            unsigned short c0 = static_cast<unsigned short>(linha[kx]);
+            unsigned short c1 = (kx + 1 < tamanhoKernel) ? static_cast<unsigned short>(linha[kx + 1]) : 0;
+            pares[ky * paresPorLinha + p] = static_cast<int>(c0 | (static_cast<unsigned int>(c1) << 16));
+        }
+    }
+
+    return pares;
+}
+
+int Simd::convolucaoInteiraLinha(const uchar* const* linhas, const int* pares, int tamanhoKernel,
+                                 int deslocamento, uchar* saida, int largura) {
+    switch (nivelAtivo()) {
+        case NivelSimd::AVX2:
+            return convolucaoInteiraLinhaAVX2(linhas, pares, tamanhoKernel, deslocamento, saida, largura);
+        case NivelSimd::SSE41:
+            return convolucaoInteiraLinhaSSE41(linhas, pares, tamanhoKernel, deslocamento, saida, largura);
+        case NivelSimd::NEON:
+            return convolucaoInteiraLinhaNEON(linhas, pares, tamanhoKernel, deslocamento, saida, largura);
+        case NivelSimd::ESCALAR:
+        default:
+            return 0;
+    }
+}
+
+int Simd::cinzaPonderadoLinha(const uchar* bgr, uchar* cinza, int largura) {
+    switch (nivelAtivo()) {
+        case NivelSimd::AVX2:
+            return cinzaLinhaAVX2(bgr, cinza, largura, true);
+        case NivelSimd::SSE41:
+            return cinzaLinhaSSE41(bgr, cinza, largura, true);
+        case NivelSimd::NEON:
+            return cinzaLinhaNEON(bgr, cinza, largura, true);
+        case NivelSimd::ESCALAR:
+        default:
+            return 0;
+    }
+}
+
+int Simd::cinzaMediaLinha(const uchar* bgr, uchar* cinza, int largura) {
+    switch (nivelAtivo()) {
+        case NivelSimd::AVX2:
+            return cinzaLinhaAVX2(bgr, cinza, largura, false);
+        case NivelSimd::SSE41:
+            return cinzaLinhaSSE41(bgr, cinza, largura, false);
+        case NivelSimd::NEON:
+            return cinzaLinhaNEON(bgr, cinza, largura, false);
+        case NivelSimd::ESCALAR:
+        default:
+            return 0;
+    }
+}
+
+int Simd::minimoLinha(const uchar* a, const uchar* b, uchar* destino, int largura) {
+    switch (nivelAtivo()) {
+        case NivelSimd::AVX2:
+            return minMaxLinhaAVX2(a, b, destino, largura, true);
+        case NivelSimd::SSE41:
+            return minMaxLinhaSSE41(a, b, destino, largura, true);
+        case NivelSimd::NEON:
+            return minMaxLinhaNEON(a, b, destino, largura, true);
+        case NivelSimd::ESCALAR:
+        default:
+            return 0;
+    }
+}
+
+int Simd::maximoLinha(const uchar* a, const uchar* b, uchar* destino, int largura) {
+    switch (nivelAtivo()) {
+        case NivelSimd::AVX2:
+            return minMaxLinhaAVX2(a, b, destino, largura, false);
+        case NivelSimd::SSE41:
+            return minMaxLinhaSSE41(a, b, destino, largura, false);
+        case NivelSimd::NEON:
+            return minMaxLinhaNEON(a, b, destino, largura, false);
+        case NivelSimd::ESCALAR:
+        default:
+            return 0;
+    }
+}
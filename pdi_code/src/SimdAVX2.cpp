@@ -0,0 +1,135 @@
+#include "Simd.hpp"
+
+#if defined(PDI_SIMD_X86)
+
+#include <immintrin.h>
+
+// Todo o código abaixo é gerado para AVX2; só roda se a CPU suportar
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+namespace {
+
+struct VetorAVX2 {
+    static const int LARGURA = 16;
+    typedef __m256i Acumulador;
+
+    static inline Acumulador zero() {
+        return _mm256_setzero_si256();
+    }
+
+    static inline void macPar(Acumulador& lo, Acumulador& hi, const uchar* p, int par) {
+        // unpack opera por metade de 128 bits: lo = x0..3 | x8..11, hi = x4..7 | x12..15
+        __m256i a = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+        __m256i b = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 1)));
+        __m256i coef = _mm256_set1_epi32(par);
+        lo = _mm256_add_epi32(lo, _mm256_madd_epi16(_mm256_unpacklo_epi16(a, b), coef));
+        hi = _mm256_add_epi32(hi, _mm256_madd_epi16(_mm256_unpackhi_epi16(a, b), coef));
+    }
+
+    static inline void armazenar(uchar* destino, Acumulador lo, Acumulador hi, int deslocamento) {
+        __m128i s = _mm_cvtsi32_si128(deslocamento);
+        // packs por metade reordena para x0..7 | x8..15
+        __m256i v16 = _mm256_packs_epi32(_mm256_sra_epi32(lo, s), _mm256_sra_epi32(hi, s));
+        __m256i v8 = _mm256_packus_epi16(v16, v16);
+        v8 = _mm256_permute4x64_epi64(v8, 0x08);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destino), _mm256_castsi256_si128(v8));
+    }
+
+    typedef __m256i Pixels;
+
+    static inline void separarBGR8(const uchar* p, __m128i& b, __m128i& g, __m128i& r) {
+        // 8 pixels = 24 bytes; pshufb separa os canais já estendidos para 16 bits
+        __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i v1 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(p + 16));
+        b = _mm_or_si128(_mm_shuffle_epi8(v0, _mm_setr_epi8(0, -1, 3, -1, 6, -1, 9, -1, 12, -1, 15, -1, -1, -1, -1, -1)),
+                         _mm_shuffle_epi8(v1, _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 2, -1, 5, -1)));
+        g = _mm_or_si128(_mm_shuffle_epi8(v0, _mm_setr_epi8(1, -1, 4, -1, 7, -1, 10, -1, 13, -1, -1, -1, -1, -1, -1, -1)),
+                         _mm_shuffle_epi8(v1, _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, -1, 3, -1, 6, -1)));
+        r = _mm_or_si128(_mm_shuffle_epi8(v0, _mm_setr_epi8(2, -1, 5, -1, 8, -1, 11, -1, 14, -1, -1, -1, -1, -1, -1, -1)),
+                         _mm_shuffle_epi8(v1, _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 1, -1, 4, -1, 7, -1)));
+    }
+
+    static inline void carregarBGR(const uchar* p, Pixels& b, Pixels& g, Pixels& r) {
+        // Pixels 0-7 na metade baixa e 8-15 na alta, como em macPar
+        __m128i b0, g0, r0, b1, g1, r1;
+        separarBGR8(p, b0, g0, r0);
+        separarBGR8(p + 24, b1, g1, r1);
+        b = _mm256_inserti128_si256(_mm256_castsi128_si256(b0), b1, 1);
+        g = _mm256_inserti128_si256(_mm256_castsi128_si256(g0), g1, 1);
+        r = _mm256_inserti128_si256(_mm256_castsi128_si256(r0), r1, 1);
+    }
+
+    static inline void macPixels(Acumulador& lo, Acumulador& hi, Pixels a, Pixels b, int par) {
+        __m256i coef = _mm256_set1_epi32(par);
+        lo = _mm256_add_epi32(lo, _mm256_madd_epi16(_mm256_unpacklo_epi16(a, b), coef));
+        hi = _mm256_add_epi32(hi, _mm256_madd_epi16(_mm256_unpackhi_epi16(a, b), coef));
+    }
+
+    static inline Acumulador multiplicarDeslocar(Acumulador v, int multiplicador, int deslocamento) {
+        return _mm256_sra_epi32(_mm256_mullo_epi32(v, _mm256_set1_epi32(multiplicador)),
+                                _mm_cvtsi32_si128(deslocamento));
+    }
+
+    static const int BYTES = 32;
+    typedef __m256i Bytes;
+
+    static inline Bytes carregarBytes(const uchar* p) {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    }
+
+    static inline void guardarBytes(uchar* p, Bytes v) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+    }
+
+    static inline Bytes minimoBytes(Bytes a, Bytes b) {
+        return _mm256_min_epu8(a, b);
+    }
+
+    static inline Bytes maximoBytes(Bytes a, Bytes b) {
+        return _mm256_max_epu8(a, b);
+    }
+};
+
+#include "SimdNucleos.inl"
+
+}
+
+int Simd::convolucaoInteiraLinhaAVX2(const uchar* const* linhas, const int* pares, int tamanhoKernel,
+                                     int deslocamento, uchar* saida, int largura) {
+    return despacharConvolucaoInteira<VetorAVX2>(linhas, pares, tamanhoKernel, deslocamento, saida, largura);
+}
+
+int Simd::cinzaLinhaAVX2(const uchar* bgr, uchar* cinza, int largura, bool ponderada) {
+    return nucleoCinza<VetorAVX2>(bgr, cinza, largura, ponderada);
+}
+
+int Simd::minMaxLinhaAVX2(const uchar* a, const uchar* b, uchar* destino, int largura, bool minimo) {
+    return nucleoMinMaxLinha<VetorAVX2>(a, b, destino, largura, minimo);
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#else
+
+int Simd::convolucaoInteiraLinhaAVX2(const uchar* const*, const int*, int, int, uchar*, int) {
+    return 0;
+}
+
+int Simd::cinzaLinhaAVX2(const uchar*, uchar*, int, bool) {
+    return 0;
+}
+
+int Simd::minMaxLinhaAVX2(const uchar*, const uchar*, uchar*, int, bool) {
+    return 0;
+}
+
+#endif
@@ -0,0 +1,109 @@
+#include "Simd.hpp"
+
+#if defined(PDI_SIMD_NEON)
+
+#include <arm_neon.h>
+
+namespace {
+
+struct VetorNEON {
+    static const int LARGURA = 8;
+    typedef int32x4_t Acumulador;
+
+    static inline Acumulador zero() {
+        return vdupq_n_s32(0);
+    }
+
+    static inline void macPar(Acumulador& lo, Acumulador& hi, const uchar* p, int par) {
+        int16x8_t a = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(p)));
+        int16x8_t b = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(p + 1)));
+        int16_t c0 = static_cast<int16_t>(par & 0xFFFF);
+        int16_t c1 = static_cast<int16_t>(par >> 16);
+        lo = vmlal_n_s16(lo, vget_low_s16(a), c0);
+        lo = vmlal_n_s16(lo, vget_low_s16(b), c1);
+        hi = vmlal_n_s16(hi, vget_high_s16(a), c0);
+        hi = vmlal_n_s16(hi, vget_high_s16(b), c1);
+    }
+
+    static inline void armazenar(uchar* destino, Acumulador lo, Acumulador hi, int deslocamento) {
+        // Deslocamento negativo em vshlq = deslocamento aritmético à direita
+        int32x4_t s = vdupq_n_s32(-deslocamento);
+        int16x8_t v16 = vcombine_s16(vqmovn_s32(vshlq_s32(lo, s)), vqmovn_s32(vshlq_s32(hi, s)));
+        vst1_u8(destino, vqmovun_s16(v16));
+    }
+
+    typedef int16x8_t Pixels;
+
+    static inline void carregarBGR(const uchar* p, Pixels& b, Pixels& g, Pixels& r) {
+        // vld3 separa os canais intercalados diretamente
+        uint8x8x3_t canais = vld3_u8(p);
+        b = vreinterpretq_s16_u16(vmovl_u8(canais.val[0]));
+        g = vreinterpretq_s16_u16(vmovl_u8(canais.val[1]));
+        r = vreinterpretq_s16_u16(vmovl_u8(canais.val[2]));
+    }
+
+    static inline void macPixels(Acumulador& lo, Acumulador& hi, Pixels a, Pixels b, int par) {
+        int16_t c0 = static_cast<int16_t>(par & 0xFFFF);
+        int16_t c1 = static_cast<int16_t>(par >> 16);
+        lo = vmlal_n_s16(lo, vget_low_s16(a), c0);
+        lo = vmlal_n_s16(lo, vget_low_s16(b), c1);
+        hi = vmlal_n_s16(hi, vget_high_s16(a), c0);
+        hi = vmlal_n_s16(hi, vget_high_s16(b), c1);
+    }
+
+    static inline Acumulador multiplicarDeslocar(Acumulador v, int multiplicador, int deslocamento) {
+        return vshlq_s32(vmulq_n_s32(v, multiplicador), vdupq_n_s32(-deslocamento));
+    }
+
+    static const int BYTES = 16;
+    typedef uint8x16_t Bytes;
+
+    static inline Bytes carregarBytes(const uchar* p) {
+        return vld1q_u8(p);
+    }
+
+    static inline void guardarBytes(uchar* p, Bytes v) {
+        vst1q_u8(p, v);
+    }
+
+    static inline Bytes minimoBytes(Bytes a, Bytes b) {
+        return vminq_u8(a, b);
+    }
+
+    static inline Bytes maximoBytes(Bytes a, Bytes b) {
+        return vmaxq_u8(a, b);
+    }
+};
+
+#include "SimdNucleos.inl"
+
+}
+
+int Simd::convolucaoInteiraLinhaNEON(const uchar* const* linhas, const int* pares, int tamanhoKernel,
+                                     int deslocamento, uchar* saida, int largura) {
+    return despacharConvolucaoInteira<VetorNEON>(linhas, pares, tamanhoKernel, deslocamento, saida, largura);
+}
+
+int Simd::cinzaLinhaNEON(const uchar* bgr, uchar* cinza, int largura, bool ponderada) {
+    return nucleoCinza<VetorNEON>(bgr, cinza, largura, ponderada);
+}
+
+int Simd::minMaxLinhaNEON(const uchar* a, const uchar* b, uchar* destino, int largura, bool minimo) {
+    return nucleoMinMaxLinha<VetorNEON>(a, b, destino, largura, minimo);
+}
+
+#else
+
+int Simd::convolucaoInteiraLinhaNEON(const uchar* const*, const int*, int, int, uchar*, int) {
+    return 0;
+}
+
+int Simd::cinzaLinhaNEON(const uchar*, uchar*, int, bool) {
+    return 0;
+}
+
+int Simd::minMaxLinhaNEON(const uchar*, const uchar*, uchar*, int, bool) {
+    return 0;
+}
+
+#endif
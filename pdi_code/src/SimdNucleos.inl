@@ -0,0 +1,121 @@
+// Núcleos SIMD genéricos, escritos uma única vez sobre o wrapper V.
+//
+// Este arquivo é incluído por SimdSSE41.cpp, SimdAVX2.cpp e SimdNEON.cpp dentro
+// da região compilada para o conjunto de instruções correspondente. Cada um
+// desses arquivos define o wrapper V com a interface:
+//
+//   LARGURA                       pixels processados por iteração
+//   Acumulador                    registrador de somas int32
+//   zero()                        acumulador zerado
+//   macPar(lo, hi, p, par)        lo/hi += p[i] * c0 + p[i + 1] * c1, i = 0..LARGURA-1
+//                                 (par = c0 | c1 << 16, coeficientes int16)
+//   armazenar(d, lo, hi, s)       d[i] = sat8(acumulador[i] >> s)
+//
+// Para a conversão BGR -> cinza:
+//
+//   Pixels                        LARGURA valores de 16 bits
+//   carregarBGR(p, b, g, r)       separa LARGURA pixels BGR intercalados
+//   macPixels(lo, hi, a, b, par)  lo/hi += a[i] * c0 + b[i] * c1 (mesma ordem de macPar)
+//   multiplicarDeslocar(v, m, s)  v[i] = (v[i] * m) >> s
+//
+// Para mínimo/máximo de bytes:
+//
+//   BYTES                         bytes por registrador
+//   Bytes                         registrador de BYTES valores de 8 bits
+//   carregarBytes(p)              leitura não alinhada
+//   guardarBytes(p, v)            escrita não alinhada
+//   minimoBytes(a, b)             mínimo sem sinal, byte a byte
+//   maximoBytes(a, b)             máximo sem sinal, byte a byte
+//
+// A ordem interna das pistas em lo/hi é definida pelo wrapper; apenas
+// armazenar() precisa conhecê-la.
+
+template <typename V, int K>
+static int nucleoConvolucaoInteira(const uchar* const* linhas, const int* pares, int tamanhoKernel,
+                                   int deslocamento, uchar* saida, int largura) {
+    // K > 0 fixa o tamanho em tempo de compilação (laços desenrolados para 3x3 e 5x5)
+    const int k = (K > 0) ? K : tamanhoKernel;
+    const int paresPorLinha = (k + 1) / 2;
+
+    int x = 0;
+    for (; x + V::LARGURA <= largura; x += V::LARGURA) {
+        typename V::Acumulador lo = V::zero();
+        typename V::Acumulador hi = V::zero();
+
+        const int* par = pares;
+        for (int ky = 0; ky < k; ky++) {
+            const uchar* pixels = linhas[ky] + x;
+            for (int p = 0; p < paresPorLinha; p++) {
+                V::macPar(lo, hi, pixels + 2 * p, par[p]);
+            }
+            par += paresPorLinha;
+        }
+
+        V::armazenar(saida + x, lo, hi, deslocamento);
+    }
+
+    return x;
+}
+
+template <typename V>
+static int despacharConvolucaoInteira(const uchar* const* linhas, const int* pares, int tamanhoKernel,
+                                      int deslocamento, uchar* saida, int largura) {
+    switch (tamanhoKernel) {
+        case 3:
+            return nucleoConvolucaoInteira<V, 3>(linhas, pares, tamanhoKernel, deslocamento, saida, largura);
+        case 5:
+            return nucleoConvolucaoInteira<V, 5>(linhas, pares, tamanhoKernel, deslocamento, saida, largura);
+        default:
+            return nucleoConvolucaoInteira<V, 0>(linhas, pares, tamanhoKernel, deslocamento, saida, largura);
+    }
+}
+
+// Pesos BT.601 em milésimos: cinza = (114*B + 587*G + 299*R) / 1000 (divisão inteira)
+static const int PAR_PESOS_BG = 114 | (587 << 16);
+static const int PESO_R = 299;
+
+template <typename V>
+static int nucleoCinza(const uchar* bgr, uchar* cinza, int largura, bool ponderada) {
+    int x = 0;
+    for (; x + V::LARGURA <= largura; x += V::LARGURA) {
+        typename V::Pixels b, g, r;
+        V::carregarBGR(bgr + 3 * x, b, g, r);
+
+        typename V::Acumulador lo = V::zero();
+        typename V::Acumulador hi = V::zero();
+
+        if (ponderada) {
+            // n <= 255000; n / 1000 = (n >> 3) / 125, e (q * 67109) >> 23 == q / 125 para q <= 31875
+            V::macPixels(lo, hi, b, g, PAR_PESOS_BG);
+            V::macPixels(lo, hi, r, r, PESO_R);
+            lo = V::multiplicarDeslocar(V::multiplicarDeslocar(lo, 1, 3), 67109, 23);
+            hi = V::multiplicarDeslocar(V::multiplicarDeslocar(hi, 1, 3), 67109, 23);
+        } else {
+            // s <= 765; (s * 43691) >> 17 == s / 3
+            V::macPixels(lo, hi, b, g, 1 | (1 << 16));
+            V::macPixels(lo, hi, r, r, 1);
+            lo = V::multiplicarDeslocar(lo, 43691, 17);
+            hi = V::multiplicarDeslocar(hi, 43691, 17);
+        }
+
+        V::armazenar(cinza + x, lo, hi, 0);
+    }
+
+    return x;
+}
+
+template <typename V>
+static int nucleoMinMaxLinha(const uchar* a, const uchar* b, uchar* destino, int largura, bool minimo) {
+    // Cada bloco é lido antes de ser escrito: destino pode coincidir com a ou b
+    int x = 0;
+    if (minimo) {
+        for (; x + V::BYTES <= largura; x += V::BYTES) {
+            V::guardarBytes(destino + x, V::minimoBytes(V::carregarBytes(a + x), V::carregarBytes(b + x)));
+        }
+    } else {
+        for (; x + V::BYTES <= largura; x += V::BYTES) {
+            V::guardarBytes(destino + x, V::maximoBytes(V::carregarBytes(a + x), V::carregarBytes(b + x)));
+        }
+    }
+    return x;
+}
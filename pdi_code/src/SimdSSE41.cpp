@@ -0,0 +1,122 @@
+#include "Simd.hpp"
+
+#if defined(PDI_SIMD_X86)
+
+#include <smmintrin.h>
+
+// Todo o código abaixo é gerado para SSE4.1; só roda se a CPU suportar
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("sse4.1"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse4.1")
+#endif
+
+namespace {
+
+struct VetorSSE41 {
+    static const int LARGURA = 8;
+    typedef __m128i Acumulador;
+
+    static inline Acumulador zero() {
+        return _mm_setzero_si128();
+    }
+
+    static inline void macPar(Acumulador& lo, Acumulador& hi, const uchar* p, int par) {
+        // Intercala p[i] e p[i+1] em int16 e usa madd: p[i]*c0 + p[i+1]*c1 em int32
+        __m128i a = _mm_cvtepu8_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p)));
+        __m128i b = _mm_cvtepu8_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p + 1)));
+        __m128i coef = _mm_set1_epi32(par);
+        lo = _mm_add_epi32(lo, _mm_madd_epi16(_mm_unpacklo_epi16(a, b), coef));
+        hi = _mm_add_epi32(hi, _mm_madd_epi16(_mm_unpackhi_epi16(a, b), coef));
+    }
+
+    static inline void armazenar(uchar* destino, Acumulador lo, Acumulador hi, int deslocamento) {
+        __m128i s = _mm_cvtsi32_si128(deslocamento);
+        __m128i v16 = _mm_packs_epi32(_mm_sra_epi32(lo, s), _mm_sra_epi32(hi, s));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(destino), _mm_packus_epi16(v16, v16));
+    }
+
+    typedef __m128i Pixels;
+
+    static inline void carregarBGR(const uchar* p, Pixels& b, Pixels& g, Pixels& r) {
+        // 8 pixels = 24 bytes: bytes 0-15 em v0 e 16-23 em v1; pshufb já estende para 16 bits
+        // (índice -1 zera o byte alto de cada pista)
+        __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i v1 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(p + 16));
+        b = _mm_or_si128(_mm_shuffle_epi8(v0, _mm_setr_epi8(0, -1, 3, -1, 6, -1, 9, -1, 12, -1, 15, -1, -1, -1, -1, -1)),
+                         _mm_shuffle_epi8(v1, _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 2, -1, 5, -1)));
+        g = _mm_or_si128(_mm_shuffle_epi8(v0, _mm_setr_epi8(1, -1, 4, -1, 7, -1, 10, -1, 13, -1, -1, -1, -1, -1, -1, -1)),
+                         _mm_shuffle_epi8(v1, _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, -1, 3, -1, 6, -1)));
+        r = _mm_or_si128(_mm_shuffle_epi8(v0, _mm_setr_epi8(2, -1, 5, -1, 8, -1, 11, -1, 14, -1, -1, -1, -1, -1, -1, -1)),
+                         _mm_shuffle_epi8(v1, _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 1, -1, 4, -1, 7, -1)));
+    }
+
+    static inline void macPixels(Acumulador& lo, Acumulador& hi, Pixels a, Pixels b, int par) {
+        __m128i coef = _mm_set1_epi32(par);
+        lo = _mm_add_epi32(lo, _mm_madd_epi16(_mm_unpacklo_epi16(a, b), coef));
+        hi = _mm_add_epi32(hi, _mm_madd_epi16(_mm_unpackhi_epi16(a, b), coef));
+    }
+
+    static inline Acumulador multiplicarDeslocar(Acumulador v, int multiplicador, int deslocamento) {
+        return _mm_sra_epi32(_mm_mullo_epi32(v, _mm_set1_epi32(multiplicador)), _mm_cvtsi32_si128(deslocamento));
+    }
+
+    static const int BYTES = 16;
+    typedef __m128i Bytes;
+
+    static inline Bytes carregarBytes(const uchar* p) {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    }
+
+    static inline void guardarBytes(uchar* p, Bytes v) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+    }
+
+    static inline Bytes minimoBytes(Bytes a, Bytes b) {
+        return _mm_min_epu8(a, b);
+    }
+
+    static inline Bytes maximoBytes(Bytes a, Bytes b) {
+        return _mm_max_epu8(a, b);
+    }
+};
+
+#include "SimdNucleos.inl"
+
+}
+
+int Simd::convolucaoInteiraLinhaSSE41(const uchar* const* linhas, const int* pares, int tamanhoKernel,
+                                      int deslocamento, uchar* saida, int largura) {
+    return despacharConvolucaoInteira<VetorSSE41>(linhas, pares, tamanhoKernel, deslocamento, saida, largura);
+}
+
+int Simd::cinzaLinhaSSE41(const uchar* bgr, uchar* cinza, int largura, bool ponderada) {
+    return nucleoCinza<VetorSSE41>(bgr, cinza, largura, ponderada);
+}
+
+int Simd::minMaxLinhaSSE41(const uchar* a, const uchar* b, uchar* destino, int largura, bool minimo) {
+    return nucleoMinMaxLinha<VetorSSE41>(a, b, destino, largura, minimo);
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#else
+
+int Simd::convolucaoInteiraLinhaSSE41(const uchar* const*, const int*, int, int, uchar*, int) {
+    return 0;
+}
+
+int Simd::cinzaLinhaSSE41(const uchar*, uchar*, int, bool) {
+    return 0;
+}
+
+int Simd::minMaxLinhaSSE41(const uchar*, const uchar*, uchar*, int, bool) {
+    return 0;
+}
+
+#endif
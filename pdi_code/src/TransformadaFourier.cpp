@@ -0,0 +1,183 @@
+#include "TransformadaFourier.hpp"
+#include <cmath>
+
+// Constantes da borboleta de raiz 5: cos/sen de 2*pi/5 e 4*pi/5
+static const double COS_2PI_5 = 0.30901699437494742;
+static const double COS_4PI_5 = -0.80901699437494742;
+static const double SEN_2PI_5 = 0.95105651629515357;
+static const double SEN_4PI_5 = 0.58778525229247313;
+
+TransformadaFourier::TransformadaFourier(int n)
+    : n(n), twiddles(n), entrada(n), saida(n) {
+    // Fatoração: 4 primeiro (borboleta mais barata por elemento), depois 2, 3, 5...
+    int restante = n;
+    while (restante % 4 == 0) {
+        fatores.push_back(4);
+        restante /= 4;
+    }
+    for (int fator = 2; restante > 1; ) {
+        if (restante % fator == 0) {
+            fatores.push_back(fator);
+            restante /= fator;
+        } else {
+            fator++;
+        }
+    }
+
+    // Fatores de rotação W_n^e = exp(-2*pi*i*e/n)
+    const double pi = std::acos(-1.0);
+    for (int e = 0; e < n; e++) {
+        double angulo = -2.0 * pi * e / n;
+        twiddles[e] = Complexo(std::cos(angulo), std::sin(angulo));
+    }
+}
+
+void TransformadaFourier::executar(Complexo* dados, bool inversa, int passo) {
+    for (int i = 0; i < n; i++) {
+        entrada[i] = dados[static_cast<size_t>(i) * passo];
+    }
+
+    fftRecursiva(entrada.data(), saida.data(), n, 1, 0, inversa);
+
+    double escala = inversa ? 1.0 / n : 1.0;
+    for (int i = 0; i < n; i++) {
+        dados[static_cast<size_t>(i) * passo] = saida[i] * escala;
+    }
+}
+
+void TransformadaFourier::fftRecursiva(const Complexo* origem, Complexo* destino, int tamanho,
+                                       int passoOrigem, size_t nivel, bool inversa) {
+    if (tamanho == 1) {
+        destino[0] = origem[0];
+        return;
+    }
+
+    int fator = fatores[nivel];
+    int m = tamanho / fator;
+
+    // Transforma as "fator" subsequências intercaladas, cada uma com m elementos
+    for (int j = 0; j < fator; j++) {
+        fftRecursiva(origem + static_cast<size_t>(j) * passoOrigem, destino + static_cast<size_t>(j) * m,
+                     m, passoOrigem * fator, nivel + 1, inversa);
+    }
+
+    // W_tamanho^e = W_n^(e * passoTwiddle)
+    int passoTwiddle = n / tamanho;
+    Complexo y[8];
+    std::vector<Complexo> yGenerico(fator > 8 ? fator : 0);
+    Complexo* valores = (fator > 8) ? yGenerico.data() : y;
+
+    for (int k = 0; k < m; k++) {
+        // Aplica os fatores de rotação às saídas das sub-FFTs
+        valores[0] = destino[k];
+        for (int j = 1; j < fator; j++) {
+            Complexo w = twiddles[static_cast<size_t>(j) * k * passoTwiddle];
+            if (inversa) {
+                w = std::conj(w);
+            }
+            valores[j] = destino[j * m + k] * w;
+        }
+
+        // Borboleta de raiz "fator"
+        switch (fator) {
+            case 2: {
+                destino[k] = valores[0] + valores[1];
+                destino[k + m] = valores[0] - valores[1];
+                break;
+            }
+            case 3: {
+                const double seno = std::sqrt(3.0) / 2.0;
+                Complexo soma = valores[1] + valores[2];
+                Complexo meio = valores[0] - 0.5 * soma;
+                Complexo dif = valores[1] - valores[2];
+                // -i * seno * dif (direta) ou +i * seno * dif (inversa)
+                Complexo rotacao = inversa ? Complexo(-seno * dif.imag(), seno * dif.real())
+                                           : Complexo(seno * dif.imag(), -seno * dif.real());
+                destino[k] = valores[0] + soma;
+                destino[k + m] = meio + rotacao;
+                destino[k + 2 * m] = meio - rotacao;
+                break;
+            }
+            case 4: {
+                Complexo a = valores[0] + valores[2];
+                Complexo b = valores[0] - valores[2];
+                Complexo c = valores[1] + valores[3];
+                Complexo d = valores[1] - valores[3];
+                // -i * d (direta) ou +i * d (inversa)
+                Complexo rotacao = inversa ? Complexo(-d.imag(), d.real()) : Complexo(d.imag(), -d.real());
+                destino[k] = a + c;
+                destino[k + m] = b + rotacao;
+                destino[k + 2 * m] = a - c;
+                destino[k + 3 * m] = b - rotacao;
+                break;
+            }
+            case 5: {
+                const double c1 = COS_2PI_5, c2 = COS_4PI_5;
+                const double s1 = SEN_2PI_5, s2 = SEN_4PI_5;
+                Complexo t1 = valores[1] + valores[4];
+                Complexo t2 = valores[2] + valores[3];
+                Complexo t3 = valores[1] - valores[4];
+                Complexo t4 = valores[2] - valores[3];
+                Complexo a1 = valores[0] + c1 * t1 + c2 * t2;
+                Complexo a2 = valores[0] + c2 * t1 + c1 * t2;
+                Complexo b1 = s1 * t3 + s2 * t4;
+                Complexo b2 = s2 * t3 - s1 * t4;
+                // -i * b (direta) ou +i * b (inversa)
+                Complexo r1 = inversa ? Complexo(-b1.imag(), b1.real()) : Complexo(b1.imag(), -b1.real());
+                Complexo r2 = inversa ? Complexo(-b2.imag(), b2.real()) : Complexo(b2.imag(), -b2.real());
+                destino[k] = valores[0] + t1 + t2;
+                destino[k + m] = a1 + r1;
+                destino[k + 2 * m] = a2 + r2;
+                destino[k + 3 * m] = a2 - r2;
+                destino[k + 4 * m] = a1 - r1;
+                break;
+            }
+            default: {
+                // DFT direta de tamanho "fator"
+                int passoRaiz = n / fator;
+                for (int q = 0; q < fator; q++) {
+                    Complexo soma = valores[0];
+                    for (int j = 1; j < fator; j++) {
+                        Complexo w = twiddles[static_cast<size_t>((j * q) % fator) * passoRaiz];
+                        if (inversa) {
+                            w = std::conj(w);
+                        }
+                        soma += valores[j] * w;
+                    }
+                    destino[k + q * m] = soma;
+                }
+                break;
+            }
+        }
+    }
+}
+
+int TransformadaFourier::tamanhoOtimo(int n) {
+    if (n <= 1) {
+        return 1;
+    }
+    for (int candidato = n; ; candidato++) {
+        int restante = candidato;
+        for (int primo : {2, 3, 5}) {
+            while (restante % primo == 0) {
+                restante /= primo;
+            }
+        }
+        if (restante == 1) {
+            return candidato;
+        }
+    }
+}
+
+void TransformadaFourier::fft2D(std::vector<Complexo>& dados, TransformadaFourier& planoLinhas,
+                                TransformadaFourier& planoColunas, bool inversa) {
+    int linhas = planoColunas.tamanho();
+    int colunas = planoLinhas.tamanho();
+
+    for (int y = 0; y < linhas; y++) {
+        planoLinhas.executar(dados.data() + static_cast<size_t>(y) * colunas, inversa);
+    }
+    for (int x = 0; x < colunas; x++) {
+        planoColunas.executar(dados.data() + x, inversa, colunas);
+    }
+}